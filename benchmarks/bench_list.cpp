@@ -0,0 +1,409 @@
+#include <benchmark/benchmark.h>
+#include <memory_resource>
+#include <string>
+#include <sstream>
+#include <unordered_map>
+#include "../include/allocator.h"
+#include "../include/list.h"
+#include "../include/unrolled_list.h"
+#include "../include/parallel_list.h"
+#include "../include/sorted_list.h"
+#include "../include/hash_map.h"
+#include "../include/compact_list.h"
+
+struct Person {
+    int id;
+    std::string name;
+    int age;
+
+    Person(int i = 0, std::string n = "", int a = 0)
+        : id(i), name(std::move(n)), age(a) {}
+};
+
+template <>
+struct BinarySerializer<Person> {
+    static void write(std::ostream& os, const Person& person) {
+        binary_io::write_value(os, person.id);
+        binary_io::write_value(os, person.age);
+        BinarySerializer<std::string>::write(os, person.name);
+    }
+
+    static Person read(std::istream& is) {
+        int id = binary_io::read_value<int>(is);
+        int age = binary_io::read_value<int>(is);
+        return Person(id, BinarySerializer<std::string>::read(is), age);
+    }
+};
+
+// Значения элементов; строки длиннее буфера SSO, чтобы каждое значение требовало выделения
+template <typename T>
+T make_value(int i);
+
+template <>
+int make_value<int>(int i) { return i; }
+
+template <>
+std::string make_value<std::string>(int i) { return "benchmark-string-value-" + std::to_string(i); }
+
+template <>
+Person make_value<Person>(int i) { return Person(i, "benchmark-person-name-" + std::to_string(i), i % 100); }
+
+template <typename T>
+long long touch(const T& value) { return static_cast<long long>(value); }
+
+template <>
+long long touch<std::string>(const std::string& value) { return static_cast<long long>(value.size()); }
+
+template <>
+long long touch<Person>(const Person& value) { return value.id; }
+
+// Ресурсы памяти для сравнения; каждый экземпляр создаётся заново для каждого прогона
+struct NewDeleteResource {
+    std::pmr::memory_resource* get() { return std::pmr::new_delete_resource(); }
+};
+
+struct CustomResource {
+    CustomMemoryResource resource;
+    std::pmr::memory_resource* get() { return &resource; }
+};
+
+struct CustomSlabResource {
+    CustomMemoryResource resource{nullptr, 64 * 1024};
+    std::pmr::memory_resource* get() { return &resource; }
+};
+
+struct FastSlabResource {
+    FastMemoryResource resource;
+    std::pmr::memory_resource* get() { return &resource; }
+};
+
+struct PoolResource {
+    std::pmr::unsynchronized_pool_resource resource;
+    std::pmr::memory_resource* get() { return &resource; }
+};
+
+struct MonotonicResource {
+    std::pmr::monotonic_buffer_resource resource;
+    std::pmr::memory_resource* get() { return &resource; }
+};
+
+template <typename T>
+void fill(SingleLinkedList<T>& list, int count) {
+    for (int i = 0; i < count; ++i) {
+        list.push_front(make_value<T>(i));
+    }
+}
+
+// push_front: заполнение списка, включая его разрушение в конце прогона
+template <typename T, typename Resource>
+void BM_PushFront(benchmark::State& state) {
+    int count = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        Resource resource;
+        SingleLinkedList<T> list(resource.get());
+        fill(list, count);
+        benchmark::DoNotOptimize(list.front());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+// push_back в режиме с хвостом: то же, но в порядке вставки
+template <typename T, typename Resource>
+void BM_PushBack(benchmark::State& state) {
+    int count = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        Resource resource;
+        SingleLinkedList<T, TailTrackingPolicy> list(resource.get());
+        for (int i = 0; i < count; ++i) {
+            list.push_back(make_value<T>(i));
+        }
+        benchmark::DoNotOptimize(list.back());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+template <typename T, typename Resource>
+void BM_PopFront(benchmark::State& state) {
+    int count = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        Resource resource;
+        {
+            SingleLinkedList<T> list(resource.get());
+            fill(list, count);
+            state.ResumeTiming();
+            while (!list.empty()) {
+                list.pop_front();
+            }
+            state.PauseTiming();
+        }
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+template <typename T, typename Resource>
+void BM_Iterate(benchmark::State& state) {
+    int count = static_cast<int>(state.range(0));
+    Resource resource;
+    SingleLinkedList<T> list(resource.get());
+    fill(list, count);
+    for (auto _ : state) {
+        long long sum = 0;
+        for (const auto& value : list) {
+            sum += touch(value);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+// Параллельная свёртка по заранее построенному разбиению
+template <typename T, typename Resource>
+void BM_ParallelReduce(benchmark::State& state) {
+    int count = static_cast<int>(state.range(0));
+    Resource resource;
+    SingleLinkedList<T> list(resource.get());
+    fill(list, count);
+    auto partition = partition_list(list, 4 * std::thread::hardware_concurrency());
+    for (auto _ : state) {
+        long long sum = parallel_transform_reduce(partition, 0LL, std::plus<>(),
+                                                  [](const T& value) { return static_cast<long long>(touch(value)); });
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+// Обход развёрнутого списка с тем же содержимым
+template <typename T, typename Resource>
+void BM_IterateUnrolled(benchmark::State& state) {
+    int count = static_cast<int>(state.range(0));
+    Resource resource;
+    UnrolledSingleLinkedList<T> list(resource.get());
+    for (int i = 0; i < count; ++i) {
+        list.push_front(make_value<T>(i));
+    }
+    for (auto _ : state) {
+        long long sum = 0;
+        for (const auto& value : list) {
+            sum += touch(value);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+template <typename T, typename Resource>
+void BM_Copy(benchmark::State& state) {
+    int count = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        Resource resource;
+        {
+            SingleLinkedList<T> list(resource.get());
+            fill(list, count);
+            state.ResumeTiming();
+            SingleLinkedList<T> copy(list);
+            benchmark::DoNotOptimize(copy.front());
+            state.PauseTiming();
+        }
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+template <typename T, typename Resource>
+void BM_Clear(benchmark::State& state) {
+    int count = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        Resource resource;
+        {
+            SingleLinkedList<T> list(resource.get());
+            fill(list, count);
+            state.ResumeTiming();
+            list.clear();
+            state.PauseTiming();
+        }
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+// load: разбор сохранённого в памяти списка и построение узлов
+template <typename T, typename Resource>
+void BM_BinaryLoad(benchmark::State& state) {
+    int count = static_cast<int>(state.range(0));
+    std::string data;
+    {
+        SingleLinkedList<T> list;
+        fill(list, count);
+        std::ostringstream out;
+        list.save(out);
+        data = out.str();
+    }
+    for (auto _ : state) {
+        state.PauseTiming();
+        Resource resource;
+        {
+            SingleLinkedList<T> list(resource.get());
+            std::istringstream in(data);
+            state.ResumeTiming();
+            list.load(in);
+            benchmark::DoNotOptimize(list.front());
+            state.PauseTiming();
+        }
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(data.size()));
+}
+
+#define LIST_BENCHMARK(func, T, Resource) \
+    BENCHMARK_TEMPLATE(func, T, Resource)->RangeMultiplier(10)->Range(10, 10000000)->Unit(benchmark::kMicrosecond)
+
+#define LIST_BENCHMARKS_FOR_RESOURCE(T, Resource) \
+    LIST_BENCHMARK(BM_PushFront, T, Resource);    \
+    LIST_BENCHMARK(BM_PushBack, T, Resource);     \
+    LIST_BENCHMARK(BM_PopFront, T, Resource);     \
+    LIST_BENCHMARK(BM_Iterate, T, Resource);      \
+    LIST_BENCHMARK(BM_IterateUnrolled, T, Resource); \
+    LIST_BENCHMARK(BM_ParallelReduce, T, Resource); \
+    LIST_BENCHMARK(BM_Copy, T, Resource);         \
+    LIST_BENCHMARK(BM_BinaryLoad, T, Resource);   \
+    LIST_BENCHMARK(BM_Clear, T, Resource)
+
+#define LIST_BENCHMARKS(T)                                   \
+    LIST_BENCHMARKS_FOR_RESOURCE(T, CustomResource);         \
+    LIST_BENCHMARKS_FOR_RESOURCE(T, CustomSlabResource);     \
+    LIST_BENCHMARKS_FOR_RESOURCE(T, FastSlabResource);       \
+    LIST_BENCHMARKS_FOR_RESOURCE(T, NewDeleteResource);      \
+    LIST_BENCHMARKS_FOR_RESOURCE(T, PoolResource);           \
+    LIST_BENCHMARKS_FOR_RESOURCE(T, MonotonicResource)
+
+LIST_BENCHMARKS(int);
+LIST_BENCHMARKS(std::string);
+LIST_BENCHMARKS(Person);
+
+// Горячий путь самого ресурса: выделение и освобождение блока размера узла
+template <typename Resource>
+void BM_AllocateDeallocate(benchmark::State& state) {
+    Resource resource;
+    size_t bytes = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        void* ptr = resource.get()->allocate(bytes, alignof(std::max_align_t));
+        benchmark::DoNotOptimize(ptr);
+        resource.get()->deallocate(ptr, bytes, alignof(std::max_align_t));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(BM_AllocateDeallocate, CustomResource)->RangeMultiplier(4)->Range(16, 4096);
+BENCHMARK_TEMPLATE(BM_AllocateDeallocate, CustomSlabResource)->RangeMultiplier(4)->Range(16, 4096);
+BENCHMARK_TEMPLATE(BM_AllocateDeallocate, FastSlabResource)->RangeMultiplier(4)->Range(16, 4096);
+BENCHMARK_TEMPLATE(BM_AllocateDeallocate, NewDeleteResource)->RangeMultiplier(4)->Range(16, 4096);
+BENCHMARK_TEMPLATE(BM_AllocateDeallocate, PoolResource)->RangeMultiplier(4)->Range(16, 4096);
+
+// Поиск в отсортированном списке: разреженный индекс против линейного прохода
+void BM_SortedFind(benchmark::State& state) {
+    CustomSlabResource resource;
+    int count = static_cast<int>(state.range(0));
+    std::vector<int> values(static_cast<size_t>(count));
+    for (int i = 0; i < count; ++i) values[static_cast<size_t>(i)] = i * 2;
+    SortedSingleLinkedList<int> list(values.begin(), values.end(), resource.get());
+    int key = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(list.find(key));
+        key = (key + 7919) % (2 * count);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_LinearFind(benchmark::State& state) {
+    CustomSlabResource resource;
+    int count = static_cast<int>(state.range(0));
+    SingleLinkedList<int> list(resource.get());
+    for (int i = count; i-- > 0;) list.push_front(i * 2);
+    int key = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::find(list.begin(), list.end(), key));
+        key = (key + 7919) % (2 * count);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_SortedFind)->RangeMultiplier(10)->Range(100, 1000000);
+BENCHMARK(BM_LinearFind)->RangeMultiplier(10)->Range(100, 1000000);
+
+// Поиск по строковому ключу: цепочки с кэшированным хэшем против std::pmr::unordered_map
+template <typename Map>
+void BM_HashFind(benchmark::State& state) {
+    CustomSlabResource resource;
+    int count = static_cast<int>(state.range(0));
+    Map map(resource.get());
+    std::vector<std::string> keys;
+    for (int i = 0; i < count; ++i) {
+        keys.push_back(make_value<std::string>(i));
+        map[keys.back()] = i;
+    }
+    size_t next = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(map.find(keys[next]));
+        next = (next + 7919) % keys.size();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Вставка с ростом таблицы: худшая операция показывает паузы на перехэширование
+template <typename Map>
+void BM_HashInsert(benchmark::State& state) {
+    int count = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        CustomSlabResource resource;
+        Map map(resource.get());
+        for (int i = 0; i < count; ++i) map[i] = i;
+        benchmark::DoNotOptimize(map.size());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+BENCHMARK_TEMPLATE(BM_HashFind, ChainedHashMap<std::string, int>)->RangeMultiplier(100)->Range(100, 1000000);
+BENCHMARK_TEMPLATE(BM_HashFind, std::pmr::unordered_map<std::string, int>)->RangeMultiplier(100)->Range(100, 1000000);
+BENCHMARK_TEMPLATE(BM_HashInsert, ChainedHashMap<int, int>)->Arg(1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_HashInsert, std::pmr::unordered_map<int, int>)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+// Компактные узлы с индексными ссылками против обычных узлов на том же ресурсе
+template <typename List>
+void BM_NodeLayoutPushFront(benchmark::State& state) {
+    int count = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        CustomSlabResource resource;
+        List list(&resource.resource);
+        for (int i = 0; i < count; ++i) list.push_front(i);
+        benchmark::DoNotOptimize(list.front());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+template <typename List>
+void BM_NodeLayoutIterate(benchmark::State& state) {
+    int count = static_cast<int>(state.range(0));
+    CustomSlabResource resource;
+    List list(&resource.resource);
+    for (int i = 0; i < count; ++i) list.push_front(i);
+    for (auto _ : state) {
+        long long sum = 0;
+        for (int value : list) sum += value;
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+BENCHMARK_TEMPLATE(BM_NodeLayoutPushFront, SingleLinkedList<int>)->Arg(1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_NodeLayoutPushFront, CompactSingleLinkedList<int, CustomMemoryResource>)
+    ->Arg(1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_NodeLayoutIterate, SingleLinkedList<int>)->Arg(1000000)->Arg(10000000)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_NodeLayoutIterate, CompactSingleLinkedList<int, CustomMemoryResource>)
+    ->Arg(1000000)->Arg(10000000)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
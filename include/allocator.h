@@ -2,79 +2,885 @@
 #define CUSTOM_MEMORY_RESOURCE_H
 
 #include <memory_resource>
+#include <memory>
 #include <map>
+#include <algorithm>
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
 #include <stdexcept>
-#include <iostream>
+#include "batch_resource.h"
+#include "trace.h"
 
-class CustomMemoryResource : public std::pmr::memory_resource {
+// Хеш-таблица с открытой адресацией (линейное пробирование), ключ - адрес блока.
+// Удаление со сдвигом назад, поэтому надгробия не нужны.
+template <typename V>
+class AddressMap {
 private:
+    struct Entry {
+        void* key = nullptr; // nullptr - пустая ячейка
+        V value{};
+    };
+
+    std::vector<Entry> entries;
+    size_t count = 0;
+
+    static size_t hash(const void* key) noexcept {
+        uint64_t x = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(key));
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdULL;
+        x ^= x >> 33;
+        return static_cast<size_t>(x);
+    }
+
+    size_t mask() const noexcept { return entries.size() - 1; }
+
+    void grow() {
+        std::vector<Entry> old(entries.size() ? entries.size() * 2 : 16);
+        old.swap(entries);
+        for (Entry& entry : old) {
+            if (entry.key) {
+                size_t i = hash(entry.key) & mask();
+                while (entries[i].key) {
+                    i = (i + 1) & mask();
+                }
+                entries[i] = std::move(entry);
+            }
+        }
+    }
+
+public:
+    V* find(const void* key) noexcept {
+        if (entries.empty()) return nullptr;
+        for (size_t i = hash(key) & mask(); entries[i].key; i = (i + 1) & mask()) {
+            if (entries[i].key == key) return &entries[i].value;
+        }
+        return nullptr;
+    }
+
+    // Ключ не должен присутствовать в таблице
+    V& insert(void* key, V value) {
+        if ((count + 1) * 4 > entries.size() * 3) {
+            grow();
+        }
+        size_t i = hash(key) & mask();
+        while (entries[i].key) {
+            i = (i + 1) & mask();
+        }
+        entries[i].key = key;
+        entries[i].value = std::move(value);
+        ++count;
+        return entries[i].value;
+    }
+
+    bool erase(const void* key) {
+        if (entries.empty()) return false;
+        size_t i = hash(key) & mask();
+        while (entries[i].key != key) {
+            if (!entries[i].key) return false;
+            i = (i + 1) & mask();
+        }
+        // Сдвигаем назад элементы цепочки, чья исходная позиция не лежит в (i, j]
+        for (size_t j = (i + 1) & mask(); entries[j].key; j = (j + 1) & mask()) {
+            size_t home = hash(entries[j].key) & mask();
+            bool stays = (i < j) ? (home > i && home <= j) : (home > i || home <= j);
+            if (!stays) {
+                entries[i] = std::move(entries[j]);
+                i = j;
+            }
+        }
+        entries[i].key = nullptr;
+        entries[i].value = V{};
+        --count;
+        return true;
+    }
+
+    template <typename F>
+    void for_each(F&& f) {
+        for (Entry& entry : entries) {
+            if (entry.key) f(entry.key, entry.value);
+        }
+    }
+
+    size_t size() const noexcept { return count; }
+};
+
+// Счётчик с единственным писателем: обновляется relaxed-загрузкой и записью без
+// атомарного read-modify-write, а снимок можно читать из любого потока
+class RelaxedCounter {
+private:
+    std::atomic<size_t> value{0};
+
+public:
+    void add(size_t n = 1) noexcept { value.store(value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed); }
+    void sub(size_t n = 1) noexcept { value.store(value.load(std::memory_order_relaxed) - n, std::memory_order_relaxed); }
+    void raise_to(size_t n) noexcept {
+        if (n > value.load(std::memory_order_relaxed)) value.store(n, std::memory_order_relaxed);
+    }
+    size_t load() const noexcept { return value.load(std::memory_order_relaxed); }
+};
+
+// Нарушения контракта deallocate, которые обнаруживает ресурс
+enum class AllocationAnomaly {
+    UnknownPointer,
+    DoubleFree,
+    SizeMismatch,
+    AlignmentMismatch,
+};
+
+struct AnomalyEvent {
+    AllocationAnomaly kind;
+    void* ptr;
+    size_t bytes;
+    size_t alignment;
+};
+
+// Обработчик вызывается только на пути обнаружения аномалии
+using AnomalyHandler = void (*)(const AnomalyEvent& event, void* context);
+
+// Кольцевой журнал последних N аномалий; при переполнении затираются самые старые
+template <size_t N>
+class AnomalyLog {
+private:
+    AnomalyEvent events[N] = {};
+    size_t recorded = 0;
+
+public:
+    static void record(const AnomalyEvent& event, void* context) {
+        AnomalyLog& log = *static_cast<AnomalyLog*>(context);
+        log.events[log.recorded % N] = event;
+        ++log.recorded;
+    }
+
+    // Элементы от самого старого к самому новому
+    const AnomalyEvent& operator[](size_t i) const {
+        return events[(recorded > N ? recorded - N + i : i) % N];
+    }
+
+    size_t size() const { return recorded < N ? recorded : N; }
+    size_t total() const { return recorded; }
+    size_t dropped() const { return recorded - size(); }
+};
+
+// Таблица классов размеров: 16, 32, 48, затем по четыре класса на каждое удвоение
+// (64, 80, 96, 112, 128, 160, ...) до 4096. Внутренняя фрагментация не превышает 25%.
+struct SizeClassTable {
+    static constexpr size_t kMinBlockSize = 16;
+    static constexpr size_t kMaxSmallBlockSize = 4096;
+    static constexpr size_t kCount = 28;
+
+    size_t sizes[kCount] = {};
+    uint8_t lookup[kMaxSmallBlockSize / kMinBlockSize + 1] = {}; // по (bytes + 15) / 16
+
+    constexpr SizeClassTable() {
+        size_t count = 0;
+        for (size_t size = kMinBlockSize; size <= kMaxSmallBlockSize;) {
+            sizes[count++] = size;
+            size_t step = kMinBlockSize;
+            while (step * 8 <= size) {
+                step *= 2;
+            }
+            size += step;
+        }
+        size_t index = 0;
+        for (size_t slot = 0; slot <= kMaxSmallBlockSize / kMinBlockSize; ++slot) {
+            while (sizes[index] < slot * kMinBlockSize) {
+                ++index;
+            }
+            lookup[slot] = static_cast<uint8_t>(index);
+        }
+    }
+};
+
+inline constexpr SizeClassTable kSizeClasses{};
+
+// Политики проверок BasicCustomMemoryResource, выбираемые при компиляции.
+// CheckedPolicy: реестр блоков, обнаружение двойного и чужого освобождения и несовпадения
+// размера, полная статистика, обрезка и политика удержания.
+// FastPolicy: маленькие блоки всегда нарезаются из слабов, а выдача и возврат - это снятие
+// и добавление в список свободных блоков класса без метаданных блока и без проверок.
+// Класс определяется по аргументам deallocate, поэтому они обязаны совпадать с allocate.
+// Большие блоки по-прежнему учитываются в реестре; слабы возвращаются родителю только
+// при уничтожении ресурса или release(), а trim() и политика удержания недоступны.
+struct CheckedPolicy {
+    static constexpr bool checked = true;
+};
+
+struct FastPolicy {
+    static constexpr bool checked = false;
+};
+
+template <typename Policy>
+class BasicCustomMemoryResource : public BatchMemoryResource {
+public:
+    static constexpr bool kChecked = Policy::checked;
+
+    // Размер слаба FastPolicy, если он не задан явно
+    static constexpr size_t kDefaultSlabSize = 64 * 1024;
+
+    // Блок класса size выделяется с выравниванием, равным младшему биту size.
+    // Запрос (bytes, alignment) попадает в наименьший класс не меньше bytes, кратный alignment,
+    // поэтому слоты класса, нарезанные из выровненного слаба, тоже выровнены достаточно.
+    static constexpr size_t kMinBlockSize = SizeClassTable::kMinBlockSize;
+    static constexpr size_t kMaxSmallBlockSize = SizeClassTable::kMaxSmallBlockSize;
+    static constexpr size_t kSizeClassCount = SizeClassTable::kCount;
+
+    // Повторно используемый большой блок может превышать запрос не больше чем на четверть
+    static constexpr size_t kLargeReuseSlackDivisor = 4;
+
+    // Индекс класса для запроса; kSizeClassCount означает "большой" блок
+    static constexpr size_t size_class_index(size_t bytes, size_t alignment) noexcept {
+        if (bytes > kMaxSmallBlockSize || alignment > kMaxSmallBlockSize) {
+            return kSizeClassCount;
+        }
+        size_t rounded = (bytes + alignment - 1) & ~(alignment - 1);
+        if (rounded > kMaxSmallBlockSize) {
+            return kSizeClassCount;
+        }
+        return kSizeClasses.lookup[(rounded + kMinBlockSize - 1) / kMinBlockSize];
+    }
+
+    static constexpr size_t size_class_size(size_t index) noexcept {
+        return kSizeClasses.sizes[index];
+    }
+
+    static constexpr size_t size_class_alignment(size_t index) noexcept {
+        size_t size = kSizeClasses.sizes[index];
+        return size & (~size + 1);
+    }
+
+    // Гистограмма выравниваний: корзина i - выравнивание 2^i, последняя - 4096 и больше
+    static constexpr size_t kAlignmentBuckets = 13;
+
+    static constexpr size_t alignment_bucket(size_t alignment) noexcept {
+        size_t bucket = 0;
+        while ((size_t{1} << bucket) < alignment && bucket + 1 < kAlignmentBuckets) {
+            ++bucket;
+        }
+        return bucket;
+    }
+
+    // Снимок статистики; байты живых блоков считаются по размеру класса
+    struct Stats {
+        size_t bytes_from_parent = 0;   // удерживается у родителя сейчас
+        size_t blocks_from_parent = 0;  // блоков и слабов у родителя сейчас
+        size_t peak_bytes_from_parent = 0;
+        size_t bytes_live = 0;
+        size_t bytes_requested_live = 0; // сколько из bytes_live запрошено пользователями
+        size_t blocks_live = 0;
+        size_t peak_bytes_live = 0;
+        size_t allocations = 0;
+        size_t deallocations = 0;
+        size_t reuse_hits = 0;          // выдано из списков свободных блоков
+        size_t parent_fallbacks = 0;    // обращений к родителю за памятью
+        size_t size_histogram[kSizeClassCount + 1] = {}; // по классам, последняя - большие блоки
+        size_t alignment_histogram[kAlignmentBuckets] = {};
+
+        double reuse_hit_rate() const {
+            return allocations ? static_cast<double>(reuse_hits) / static_cast<double>(allocations) : 0.0;
+        }
+
+        // Доля памяти живых блоков, потерянная на округление до класса
+        double internal_fragmentation() const {
+            return bytes_live ? 1.0 - static_cast<double>(bytes_requested_live) / static_cast<double>(bytes_live) : 0.0;
+        }
+
+        // Доля памяти, взятой у родителя, которая сейчас не выдана
+        double external_fragmentation() const {
+            return bytes_from_parent
+                ? static_cast<double>(bytes_from_parent - bytes_live) / static_cast<double>(bytes_from_parent)
+                : 0.0;
+        }
+    };
+
+private:
+    struct Counters {
+        RelaxedCounter bytes_from_parent;
+        RelaxedCounter blocks_from_parent;
+        RelaxedCounter peak_bytes_from_parent;
+        RelaxedCounter bytes_live;
+        RelaxedCounter bytes_requested_live;
+        RelaxedCounter blocks_live;
+        RelaxedCounter peak_bytes_live;
+        RelaxedCounter allocations;
+        RelaxedCounter deallocations;
+        RelaxedCounter reuse_hits;
+        RelaxedCounter parent_fallbacks;
+        RelaxedCounter size_histogram[kSizeClassCount + 1];
+        RelaxedCounter alignment_histogram[kAlignmentBuckets];
+    };
+
     struct BlockInfo {
-        size_t size;
-        size_t alignment;
-        bool active;
+        size_t size = 0;
+        size_t requested = 0; // для больших блоков: размер последнего запроса
+        uint32_t alignment = 0;
+        bool active = false;
+    };
+
+    // Слаб: крупный участок памяти, нарезанный на слоты одного класса.
+    // Слабы выровнены по своему размеру, поэтому слаб находится по адресу блока маской.
+    struct Slab {
+        char* base;
+        size_t size_class;
+        size_t capacity;   // число слотов
+        size_t bumped = 0; // слотов уже нарезано
+        size_t live = 0;   // слотов выдано
+        bool releasing = false;
+        std::vector<uint64_t> live_bits;
+
+        Slab(void* start, size_t index, size_t slots)
+            : base(static_cast<char*>(start)), size_class(index), capacity(slots),
+              live_bits(kChecked ? (slots + 63) / 64 : 0, 0) {}
 
-        BlockInfo() : size(0), alignment(0), active(false) {}
-        BlockInfo(size_t s, size_t a) : size(s), alignment(a), active(true) {}
+        void set_live(size_t slot) { live_bits[slot / 64] |= uint64_t{1} << (slot % 64); }
+        void set_free(size_t slot) { live_bits[slot / 64] &= ~(uint64_t{1} << (slot % 64)); }
+        bool is_live(size_t slot) const { return (live_bits[slot / 64] >> (slot % 64)) & 1; }
+
+        size_t slot_of(const void* ptr) const {
+            return static_cast<size_t>(static_cast<const char*>(ptr) - base) / size_class_size(size_class);
+        }
+        void* slot_address(size_t slot) const { return base + slot * size_class_size(size_class); }
+    };
+
+    // Свободный блок хранит ссылку на следующий свободный блок своего класса
+    // и (в режиме слабов) на свой слаб, поэтому повторная выдача не требует поиска
+    struct FreeBlock {
+        FreeBlock* next;
+        Slab* slab;
     };
 
-    std::map<void*, BlockInfo> allocated_blocks;
+    static_assert(sizeof(FreeBlock) <= kMinBlockSize, "FreeBlock must fit into the smallest size class");
+
+    // Реестры: отдельные блоки (большие и все блоки вне режима слабов) и слабы по базовому адресу
+    AddressMap<BlockInfo> allocated_blocks;
+    AddressMap<std::unique_ptr<Slab>> slabs;
+    // Свободные большие блоки по размеру - для выбора наилучшего подходящего
+    std::multimap<size_t, void*> free_large_blocks;
     std::pmr::memory_resource* parent_allocator;
+    size_t slab_size;
+    FreeBlock* free_lists[kSizeClassCount] = {};
+    Slab* current_slabs[kSizeClassCount] = {};
+    size_t anomaly_counts[4] = {};
+    AnomalyHandler anomaly_handler = nullptr;
+    void* anomaly_context = nullptr;
+    Counters counters;
+    size_t retention_limit = SIZE_MAX;
+    size_t auto_trim_threshold = SIZE_MAX;
 
-    bool block_fits(const BlockInfo& info, size_t bytes, size_t alignment) const {
-        return !info.active && info.size >= bytes && info.alignment >= alignment;
+    void* slab_base(void* ptr) const {
+        return reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(ptr) & ~(uintptr_t{slab_size} - 1));
     }
 
-public:
-    explicit CustomMemoryResource(std::pmr::memory_resource* parent = nullptr)
-        : parent_allocator(parent ? parent : std::pmr::new_delete_resource())
-    {}
+    // Медленный путь: маркеры USDT sll:parent_allocate_{begin,end} окружают обращение к родителю
+    void* allocate_from_parent(size_t bytes, size_t alignment) {
+        SLL_TRACE_SCOPE(list_trace::Event::ParentAllocate);
+        SLL_TRACE_PROBE(parent_allocate_begin, bytes, alignment);
+        void* ptr = parent_allocator->allocate(bytes, alignment);
+        SLL_TRACE_PROBE(parent_allocate_end, bytes, ptr);
+        counters.parent_fallbacks.add();
+        counters.blocks_from_parent.add();
+        counters.bytes_from_parent.add(bytes);
+        counters.peak_bytes_from_parent.raise_to(counters.bytes_from_parent.load());
+        return ptr;
+    }
 
-    void* do_allocate(size_t bytes, size_t alignment) override {
-        // Поиск подходящего свободного блока
-        for (auto& [ptr, info] : allocated_blocks) {
-            if (block_fits(info, bytes, alignment)) {
-                info.active = true;
+    void release_to_parent(void* ptr, size_t bytes, size_t alignment) {
+        SLL_TRACE_SCOPE(list_trace::Event::ParentDeallocate);
+        SLL_TRACE_PROBE(parent_deallocate, bytes, ptr);
+        parent_allocator->deallocate(ptr, bytes, alignment);
+        counters.blocks_from_parent.sub();
+        counters.bytes_from_parent.sub(bytes);
+    }
+
+    void note_allocation(size_t index, size_t bytes, size_t alignment, size_t block_bytes) {
+        if constexpr (!kChecked) {
+            if (index < kSizeClassCount) return;
+        }
+        counters.allocations.add();
+        counters.size_histogram[index].add();
+        counters.alignment_histogram[alignment_bucket(alignment)].add();
+        counters.blocks_live.add();
+        counters.bytes_live.add(block_bytes);
+        counters.bytes_requested_live.add(bytes);
+        counters.peak_bytes_live.raise_to(counters.bytes_live.load());
+    }
+
+    void note_deallocation(size_t bytes, size_t block_bytes) {
+        counters.deallocations.add();
+        counters.blocks_live.sub();
+        counters.bytes_live.sub(block_bytes);
+        counters.bytes_requested_live.sub(bytes);
+    }
+
+    // Наилучший подходящий свободный большой блок с ограниченным перерасходом
+    void* take_large_block(size_t bytes, size_t alignment) {
+        size_t limit = bytes + bytes / kLargeReuseSlackDivisor;
+        for (auto it = free_large_blocks.lower_bound(bytes); it != free_large_blocks.end() && it->first <= limit; ++it) {
+            void* ptr = it->second;
+            if (reinterpret_cast<uintptr_t>(ptr) % alignment == 0) {
+                free_large_blocks.erase(it);
                 return ptr;
             }
         }
+        return nullptr;
+    }
 
-        // Выделение нового блока
-        void* ptr = parent_allocator->allocate(bytes, alignment);
-        allocated_blocks.emplace(ptr, BlockInfo{bytes, alignment});
+    void* allocate_tracked(size_t bytes, size_t alignment) {
+        void* ptr = allocate_from_parent(bytes, alignment);
+        try {
+            allocated_blocks.insert(ptr, BlockInfo{bytes, bytes, static_cast<uint32_t>(alignment), true});
+        } catch (...) {
+            release_to_parent(ptr, bytes, alignment);
+            throw;
+        }
         return ptr;
     }
 
-    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override {
-        // Подавляем предупреждения о неиспользуемых параметрах
-        (void)bytes;
-        (void)alignment;
-        
-        auto it = allocated_blocks.find(ptr);
-        if (it == allocated_blocks.end()) {
-            std::cout << "[CustomMemoryResource] Warning: Unknown pointer deallocated: " << ptr << "\n";
-            return;
+    // Текущий слаб класса; новый запрашивается у родителя только когда текущий исчерпан
+    Slab* slab_with_room(size_t index) {
+        Slab* slab = current_slabs[index];
+        if (!slab || slab->bumped == slab->capacity) {
+            void* base = allocate_from_parent(slab_size, slab_size);
+            try {
+                auto owned = std::make_unique<Slab>(base, index, slab_size / size_class_size(index));
+                slab = owned.get();
+                slabs.insert(base, std::move(owned));
+            } catch (...) {
+                release_to_parent(base, slab_size, slab_size);
+                throw;
+            }
+            current_slabs[index] = slab;
+        }
+        return slab;
+    }
+
+    // Нарезка очередного слота
+    void* carve_slot(size_t index) {
+        Slab* slab = slab_with_room(index);
+        size_t slot = slab->bumped++;
+        slab->set_live(slot);
+        ++slab->live;
+        return slab->slot_address(slot);
+    }
+
+    // Снятие блока со списка свободных с отметкой о выдаче
+    FreeBlock* pop_free(size_t index) {
+        FreeBlock* block = free_lists[index];
+        free_lists[index] = block->next;
+        if constexpr (kChecked) {
+            if (Slab* slab = block->slab) {
+                slab->set_live(slab->slot_of(block));
+                ++slab->live;
+            } else {
+                allocated_blocks.find(block)->active = true;
+            }
+        }
+        return block;
+    }
+
+    void push_free(size_t index, void* ptr, Slab* slab) {
+        FreeBlock* block = static_cast<FreeBlock*>(ptr);
+        block->next = free_lists[index];
+        block->slab = slab;
+        free_lists[index] = block;
+    }
+
+    void report(AllocationAnomaly kind, void* ptr, size_t bytes, size_t alignment) {
+        ++anomaly_counts[static_cast<size_t>(kind)];
+        if (anomaly_handler) {
+            anomaly_handler(AnomalyEvent{kind, ptr, bytes, alignment}, anomaly_context);
+        }
+    }
+
+    size_t retained_bytes() const noexcept {
+        return counters.bytes_from_parent.load() - counters.bytes_live.load();
+    }
+
+    // Свободные большие блоки отдаются первыми, начиная с самых крупных
+    void trim_large_blocks(size_t max_retained_bytes) {
+        while (!free_large_blocks.empty() && retained_bytes() > max_retained_bytes) {
+            auto it = std::prev(free_large_blocks.end());
+            void* ptr = it->second;
+            free_large_blocks.erase(it);
+            BlockInfo* info = allocated_blocks.find(ptr);
+            release_to_parent(ptr, info->size, info->alignment);
+            allocated_blocks.erase(ptr);
+        }
+    }
+
+    // Вне режима слабов свободные блоки отдаются по одному, начиная с крупных классов
+    void trim_blocks(size_t max_retained_bytes) {
+        for (size_t index = kSizeClassCount; index-- > 0;) {
+            while (free_lists[index] && retained_bytes() > max_retained_bytes) {
+                FreeBlock* block = free_lists[index];
+                free_lists[index] = block->next;
+                allocated_blocks.erase(block);
+                release_to_parent(block, size_class_size(index), size_class_alignment(index));
+            }
+        }
+    }
+
+    // В режиме слабов родителю возвращаются только слабы без живых блоков
+    void trim_slabs(size_t max_retained_bytes) {
+        std::vector<Slab*> victims;
+        size_t retained = retained_bytes();
+        slabs.for_each([&](void*, std::unique_ptr<Slab>& slab) {
+            if (slab->live == 0 && retained > max_retained_bytes) {
+                slab->releasing = true;
+                victims.push_back(slab.get());
+                retained -= slab_size;
+            }
+        });
+        if (victims.empty()) return;
+
+        // Убираем из списков свободные блоки освобождаемых слабов
+        for (size_t index = 0; index < kSizeClassCount; ++index) {
+            FreeBlock** link = &free_lists[index];
+            while (*link) {
+                if ((*link)->slab->releasing) {
+                    *link = (*link)->next;
+                } else {
+                    link = &(*link)->next;
+                }
+            }
+            if (current_slabs[index] && current_slabs[index]->releasing) {
+                current_slabs[index] = nullptr;
+            }
         }
 
-        if (!it->second.active) {
+        for (Slab* slab : victims) {
+            void* base = slab->base;
+            slabs.erase(base);
+            release_to_parent(base, slab_size, slab_size);
+        }
+    }
+
+    // Автоматическая обрезка с гистерезисом: если освободить не удалось, следующая
+    // попытка будет только после прироста удерживаемой памяти ещё на половину лимита
+    void maybe_auto_trim() {
+        if constexpr (kChecked) {
+            if (retained_bytes() > auto_trim_threshold) {
+                trim(retention_limit / 2);
+                size_t after = retained_bytes();
+                auto_trim_threshold = after > retention_limit ? after + retention_limit / 2 : retention_limit;
+            }
+        }
+    }
+
+    // Освобождение одного блока без автоматической обрезки; false, если блок не был выдан.
+    // slab_hint запоминает слаб последнего блока, чтобы соседние блоки не искать заново.
+    bool release_block(void* ptr, size_t bytes, size_t alignment, Slab*& slab_hint) {
+        if constexpr (!kChecked) {
+            size_t index = size_class_index(bytes, alignment);
+            if (index < kSizeClassCount) {
+                push_free(index, ptr, nullptr);
+                return true;
+            }
+        }
+        if (kChecked && slab_mode()) {
+            Slab* slab = slab_hint && slab_hint->base == slab_base(ptr) ? slab_hint : nullptr;
+            if (!slab) {
+                auto* owned = slabs.find(slab_base(ptr));
+                slab = owned ? owned->get() : nullptr;
+            }
+            if (slab) {
+                slab_hint = slab;
+                size_t slot = slab->slot_of(ptr);
+                if (slot >= slab->bumped || slab->slot_address(slot) != ptr) {
+                    report(AllocationAnomaly::UnknownPointer, ptr, bytes, alignment);
+                    return false;
+                }
+                if (!slab->is_live(slot)) {
+                    report(AllocationAnomaly::DoubleFree, ptr, bytes, alignment);
+                    throw std::logic_error("Double deallocation detected");
+                }
+                check_size_class(slab->size_class, ptr, bytes, alignment);
+                slab->set_free(slot);
+                --slab->live;
+                push_free(slab->size_class, ptr, slab);
+                note_deallocation(bytes, size_class_size(slab->size_class));
+                return true;
+            }
+        }
+
+        BlockInfo* info = allocated_blocks.find(ptr);
+        if (!info) {
+            report(AllocationAnomaly::UnknownPointer, ptr, bytes, alignment);
+            return false;
+        }
+
+        if (!info->active) {
+            report(AllocationAnomaly::DoubleFree, ptr, bytes, alignment);
             throw std::logic_error("Double deallocation detected");
         }
 
-        it->second.active = false;
+        size_t index = size_class_index(info->size, info->alignment);
+        if (index == kSizeClassCount) {
+            if (bytes != info->requested) {
+                report(AllocationAnomaly::SizeMismatch, ptr, bytes, alignment);
+            } else if (reinterpret_cast<uintptr_t>(ptr) % alignment != 0) {
+                report(AllocationAnomaly::AlignmentMismatch, ptr, bytes, alignment);
+            }
+            info->active = false;
+            note_deallocation(info->requested, info->size);
+            free_large_blocks.emplace(info->size, ptr);
+            return true;
+        }
+
+        check_size_class(index, ptr, bytes, alignment);
+        info->active = false;
+        push_free(index, ptr, nullptr);
+        note_deallocation(bytes, info->size);
+        return true;
+    }
+
+    // Пачка маленьких блоков в режиме слабов; reuse - брать сначала свободные блоки класса
+    void fill_slab_batch(void** out, size_t count, size_t bytes, size_t alignment, bool reuse) {
+        size_t index = size_class_index(bytes, alignment);
+        size_t class_size = size_class_size(index);
+        size_t filled = 0;
+        try {
+            for (; reuse && filled < count && free_lists[index]; ++filled) {
+                out[filled] = pop_free(index);
+                if constexpr (kChecked) counters.reuse_hits.add();
+                note_allocation(index, bytes, alignment, class_size);
+            }
+            while (filled < count) {
+                Slab* slab = slab_with_room(index);
+                size_t run = std::min(count - filled, slab->capacity - slab->bumped);
+                for (size_t i = 0; i < run; ++i, ++filled) {
+                    size_t slot = slab->bumped++;
+                    if constexpr (kChecked) slab->set_live(slot);
+                    out[filled] = slab->slot_address(slot);
+                    note_allocation(index, bytes, alignment, class_size);
+                }
+                slab->live += run;
+            }
+        } catch (...) {
+            while (filled > 0) {
+                --filled;
+                do_deallocate(out[filled], bytes, alignment);
+            }
+            throw;
+        }
+    }
+
+    // Запрос, с которым освобождается маленький блок, должен попадать в его класс
+    void check_size_class(size_t index, void* ptr, size_t bytes, size_t alignment) {
+        if (size_class_index(bytes, alignment) != index) {
+            report(size_class_index(bytes, 1) != index ? AllocationAnomaly::SizeMismatch
+                                                       : AllocationAnomaly::AlignmentMismatch,
+                   ptr, bytes, alignment);
+        }
+    }
+
+public:
+    // slab_size == 0: каждый блок запрашивается у родителя отдельно.
+    // Иначе маленькие блоки нарезаются из слабов указанного размера (степень двойки, не меньше kMaxSmallBlockSize).
+    // FastPolicy всегда работает в режиме слабов: при slab_bytes == 0 берётся kDefaultSlabSize.
+    explicit BasicCustomMemoryResource(std::pmr::memory_resource* parent = nullptr, size_t slab_bytes = 0)
+        : parent_allocator(parent ? parent : std::pmr::new_delete_resource()),
+          slab_size(!kChecked && slab_bytes == 0 ? kDefaultSlabSize : slab_bytes)
+    {
+        if (slab_size != 0 && (slab_size < kMaxSmallBlockSize || (slab_size & (slab_size - 1)) != 0)) {
+            throw std::invalid_argument("Slab size must be a power of two not less than kMaxSmallBlockSize");
+        }
+    }
+
+    bool slab_mode() const noexcept { return slab_size != 0; }
+
+    // Возвращает родителю свободную память, пока удерживаемый сверх живых блоков
+    // объём больше max_retained_bytes. Время работы пропорционально числу свободных блоков.
+    void trim(size_t max_retained_bytes = 0) {
+        static_assert(kChecked, "trim() requires CheckedPolicy");
+        trim_large_blocks(max_retained_bytes);
+        if (retained_bytes() <= max_retained_bytes) return;
+        if (slab_mode()) {
+            trim_slabs(max_retained_bytes);
+        } else {
+            trim_blocks(max_retained_bytes);
+        }
+    }
+
+    // Возвращает родителю всю память, включая ещё не освобождённые блоки:
+    // после вызова все ранее выданные указатели недействительны
+    void release() noexcept {
+        allocated_blocks.for_each([this](void* ptr, const BlockInfo& info) {
+            release_to_parent(ptr, info.size, info.alignment);
+        });
+        slabs.for_each([this](void* base, const std::unique_ptr<Slab>&) {
+            release_to_parent(base, slab_size, slab_size);
+        });
+        allocated_blocks = AddressMap<BlockInfo>();
+        slabs = AddressMap<std::unique_ptr<Slab>>();
+        free_large_blocks.clear();
+        for (size_t index = 0; index < kSizeClassCount; ++index) {
+            free_lists[index] = nullptr;
+            current_slabs[index] = nullptr;
+        }
+        counters.blocks_live.sub(counters.blocks_live.load());
+        counters.bytes_live.sub(counters.bytes_live.load());
+        counters.bytes_requested_live.sub(counters.bytes_requested_live.load());
+    }
+
+    // Политика верхней границы: после освобождения блока, если свободной памяти
+    // удерживается больше лимита, выполняется trim(limit / 2). SIZE_MAX отключает политику.
+    void set_retention_limit(size_t max_retained_bytes) noexcept {
+        static_assert(kChecked, "set_retention_limit() requires CheckedPolicy");
+        retention_limit = max_retained_bytes;
+        auto_trim_threshold = max_retained_bytes;
+    }
+
+    size_t retained() const noexcept {
+        static_assert(kChecked, "retained() requires CheckedPolicy");
+        return retained_bytes();
+    }
+
+    // Диагностика: счётчики аномалий и необязательный обработчик (nullptr - отключить)
+    void set_anomaly_handler(AnomalyHandler handler, void* context = nullptr) noexcept {
+        anomaly_handler = handler;
+        anomaly_context = context;
+    }
+
+    template <size_t N>
+    void set_anomaly_log(AnomalyLog<N>& log) noexcept {
+        set_anomaly_handler(&AnomalyLog<N>::record, &log);
+    }
+
+    size_t anomaly_count(AllocationAnomaly kind) const noexcept {
+        return anomaly_counts[static_cast<size_t>(kind)];
+    }
+
+    // Снимок счётчиков; безопасно вызывать из другого потока.
+    // У FastPolicy маленькие блоки не учитываются: верны только счётчики родителя и больших блоков.
+    Stats stats() const noexcept {
+        Stats result;
+        result.bytes_from_parent = counters.bytes_from_parent.load();
+        result.blocks_from_parent = counters.blocks_from_parent.load();
+        result.peak_bytes_from_parent = counters.peak_bytes_from_parent.load();
+        result.bytes_live = counters.bytes_live.load();
+        result.bytes_requested_live = counters.bytes_requested_live.load();
+        result.blocks_live = counters.blocks_live.load();
+        result.peak_bytes_live = counters.peak_bytes_live.load();
+        result.allocations = counters.allocations.load();
+        result.deallocations = counters.deallocations.load();
+        result.reuse_hits = counters.reuse_hits.load();
+        result.parent_fallbacks = counters.parent_fallbacks.load();
+        for (size_t i = 0; i <= kSizeClassCount; ++i) {
+            result.size_histogram[i] = counters.size_histogram[i].load();
+        }
+        for (size_t i = 0; i < kAlignmentBuckets; ++i) {
+            result.alignment_histogram[i] = counters.alignment_histogram[i].load();
+        }
+        return result;
+    }
+
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        SLL_TRACE_SCOPE(list_trace::Event::ResourceAllocate);
+        size_t index = size_class_index(bytes, alignment);
+
+        // FastPolicy: список свободных блоков класса или следующий слот слаба
+        if constexpr (!kChecked) {
+            if (index < kSizeClassCount) {
+                if (FreeBlock* block = free_lists[index]) {
+                    free_lists[index] = block->next;
+                    return block;
+                }
+                Slab* slab = slab_with_room(index);
+                return slab->slot_address(slab->bumped++);
+            }
+        }
+
+        // Большие блоки: наилучший подходящий из свободных или новый у родителя
+        if (index >= kSizeClassCount) {
+            if (void* ptr = take_large_block(bytes, alignment)) {
+                BlockInfo* info = allocated_blocks.find(ptr);
+                info->active = true;
+                info->requested = bytes;
+                counters.reuse_hits.add();
+                note_allocation(index, bytes, alignment, info->size);
+                return ptr;
+            }
+            void* ptr = allocate_tracked(bytes, alignment);
+            note_allocation(index, bytes, alignment, bytes);
+            return ptr;
+        }
+
+        size_t class_size = size_class_size(index);
+
+        // Переиспользование свободного блока нужного класса
+        if (free_lists[index]) {
+            FreeBlock* block = pop_free(index);
+            counters.reuse_hits.add();
+            note_allocation(index, bytes, alignment, class_size);
+            return block;
+        }
+
+        // Нарезка из слаба или выделение нового блока
+        void* ptr = slab_mode() ? carve_slot(index) : allocate_tracked(class_size, size_class_alignment(index));
+        note_allocation(index, bytes, alignment, class_size);
+        return ptr;
+    }
+
+    // Неизвестный указатель игнорируется, несовпадение размера или выравнивания
+    // только регистрируется, двойное освобождение регистрируется и бросает logic_error.
+    // У FastPolicy маленький блок без проверок кладётся в список свободных своего класса.
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override {
+        SLL_TRACE_SCOPE(list_trace::Event::ResourceDeallocate);
+        Slab* slab_hint = nullptr;
+        if (release_block(ptr, bytes, alignment, slab_hint)) {
+            maybe_auto_trim();
+        }
     }
 
     bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
         return this == &other;
     }
 
-    CustomMemoryResource(const CustomMemoryResource&) = delete;
-    CustomMemoryResource& operator=(const CustomMemoryResource&) = delete;
+protected:
+    // В режиме слабов сначала выдаются свободные блоки класса, остальные нарезаются
+    // подряд идущими слотами текущего слаба; иначе - поблочно
+    void do_allocate_batch(void** out, size_t count, size_t bytes, size_t alignment) override {
+        if (!slab_mode() || size_class_index(bytes, alignment) == kSizeClassCount) {
+            BatchMemoryResource::do_allocate_batch(out, count, bytes, alignment);
+            return;
+        }
+        fill_slab_batch(out, count, bytes, alignment, true);
+    }
+
+    // Свежие блоки нарезаются только из ещё не использованной части слабов, без свободных списков
+    void do_allocate_fresh_batch(void** out, size_t count, size_t bytes, size_t alignment) override {
+        if (!slab_mode() || size_class_index(bytes, alignment) == kSizeClassCount) {
+            BatchMemoryResource::do_allocate_fresh_batch(out, count, bytes, alignment);
+            return;
+        }
+        fill_slab_batch(out, count, bytes, alignment, false);
+    }
 
-    ~CustomMemoryResource() noexcept {
-        for (const auto& [ptr, info] : allocated_blocks) {
-            parent_allocator->deallocate(ptr, info.size, info.alignment);
+    // Обрезка по политике удержания выполняется один раз на всю пачку
+    void do_deallocate_batch(void* const* blocks, size_t count, size_t bytes, size_t alignment) override {
+        Slab* slab_hint = nullptr;
+        bool released = false;
+        for (size_t i = 0; i < count; ++i) {
+            released |= release_block(blocks[i], bytes, alignment, slab_hint);
+        }
+        if (released) {
+            maybe_auto_trim();
         }
     }
+
+public:
+    BasicCustomMemoryResource(const BasicCustomMemoryResource&) = delete;
+    BasicCustomMemoryResource& operator=(const BasicCustomMemoryResource&) = delete;
+
+    ~BasicCustomMemoryResource() noexcept {
+        release();
+    }
 };
 
+using CustomMemoryResource = BasicCustomMemoryResource<CheckedPolicy>;
+using FastMemoryResource = BasicCustomMemoryResource<FastPolicy>;
+
 #endif
\ No newline at end of file
@@ -0,0 +1,111 @@
+#ifndef BATCH_MEMORY_RESOURCE_H
+#define BATCH_MEMORY_RESOURCE_H
+
+#include <memory_resource>
+#include <cstddef>
+
+// memory_resource, умеющий выдавать и принимать сразу несколько блоков одного размера
+// за одно обращение. Каждый выданный блок можно освободить и отдельно обычным deallocate.
+class BatchMemoryResource : public std::pmr::memory_resource {
+public:
+    // Заполняет out[0..count) блоками по bytes; либо выдаёт все блоки, либо бросает исключение
+    void allocate_batch(void** out, size_t count, size_t bytes, size_t alignment) {
+        do_allocate_batch(out, count, bytes, alignment);
+    }
+
+    // То же, но блоки берутся из ещё не использованной памяти ресурса, по возможности подряд:
+    // для переноса данных в плотное хранилище. По умолчанию совпадает с allocate_batch.
+    void allocate_fresh_batch(void** out, size_t count, size_t bytes, size_t alignment) {
+        do_allocate_fresh_batch(out, count, bytes, alignment);
+    }
+
+    void deallocate_batch(void* const* blocks, size_t count, size_t bytes, size_t alignment) {
+        do_deallocate_batch(blocks, count, bytes, alignment);
+    }
+
+    // true, если deallocate ничего не делает (арена): освобождаемые блоки можно просто забыть
+    bool discards_deallocations() const noexcept {
+        return do_discards_deallocations();
+    }
+
+protected:
+    // По умолчанию - поблочно
+    virtual void do_allocate_batch(void** out, size_t count, size_t bytes, size_t alignment) {
+        size_t filled = 0;
+        try {
+            for (; filled < count; ++filled) {
+                out[filled] = allocate(bytes, alignment);
+            }
+        } catch (...) {
+            while (filled > 0) {
+                --filled;
+                deallocate(out[filled], bytes, alignment);
+            }
+            throw;
+        }
+    }
+
+    virtual void do_allocate_fresh_batch(void** out, size_t count, size_t bytes, size_t alignment) {
+        do_allocate_batch(out, count, bytes, alignment);
+    }
+
+    virtual void do_deallocate_batch(void* const* blocks, size_t count, size_t bytes, size_t alignment) {
+        for (size_t i = 0; i < count; ++i) {
+            deallocate(blocks[i], bytes, alignment);
+        }
+    }
+
+    virtual bool do_discards_deallocations() const noexcept {
+        return false;
+    }
+};
+
+// Пакетное выделение у произвольного ресурса: ресурсы без поддержки пачек обслуживаются поблочно
+inline void allocate_batch(std::pmr::memory_resource* resource, void** out, size_t count,
+                           size_t bytes, size_t alignment) {
+    if (auto* batch = dynamic_cast<BatchMemoryResource*>(resource)) {
+        batch->allocate_batch(out, count, bytes, alignment);
+        return;
+    }
+    size_t filled = 0;
+    try {
+        for (; filled < count; ++filled) {
+            out[filled] = resource->allocate(bytes, alignment);
+        }
+    } catch (...) {
+        while (filled > 0) {
+            --filled;
+            resource->deallocate(out[filled], bytes, alignment);
+        }
+        throw;
+    }
+}
+
+inline void allocate_fresh_batch(std::pmr::memory_resource* resource, void** out, size_t count,
+                                 size_t bytes, size_t alignment) {
+    if (auto* batch = dynamic_cast<BatchMemoryResource*>(resource)) {
+        batch->allocate_fresh_batch(out, count, bytes, alignment);
+        return;
+    }
+    allocate_batch(resource, out, count, bytes, alignment);
+}
+
+inline void deallocate_batch(std::pmr::memory_resource* resource, void* const* blocks, size_t count,
+                             size_t bytes, size_t alignment) {
+    if (auto* batch = dynamic_cast<BatchMemoryResource*>(resource)) {
+        batch->deallocate_batch(blocks, count, bytes, alignment);
+        return;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        resource->deallocate(blocks[i], bytes, alignment);
+    }
+}
+
+// monotonic_buffer_resource освобождает память только целиком, поэтому deallocate у него пустой
+inline bool discards_deallocations(const std::pmr::memory_resource* resource) noexcept {
+    if (dynamic_cast<const std::pmr::monotonic_buffer_resource*>(resource)) return true;
+    auto* batch = dynamic_cast<const BatchMemoryResource*>(resource);
+    return batch && batch->discards_deallocations();
+}
+
+#endif
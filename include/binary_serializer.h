@@ -0,0 +1,120 @@
+#ifndef BINARY_SERIALIZER_H
+#define BINARY_SERIALIZER_H
+
+#include <istream>
+#include <ostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <cstddef>
+#include <cstdint>
+
+// Низкоуровневые чтение и запись байтов; ошибки потока превращаются в исключения
+namespace binary_io {
+    inline void write_bytes(std::ostream& os, const void* data, size_t bytes) {
+        if (!os.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes))) {
+            throw std::runtime_error("Failed to write list data");
+        }
+    }
+
+    inline void read_bytes(std::istream& is, void* data, size_t bytes) {
+        if (!is.read(static_cast<char*>(data), static_cast<std::streamsize>(bytes))) {
+            throw std::runtime_error("Unexpected end of list data");
+        }
+    }
+
+    template <typename T>
+    void write_value(std::ostream& os, const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "write_value requires trivially copyable T");
+        write_bytes(os, &value, sizeof(T));
+    }
+
+    template <typename T>
+    T read_value(std::istream& is) {
+        static_assert(std::is_trivially_copyable_v<T>, "read_value requires trivially copyable T");
+        T value;
+        read_bytes(is, &value, sizeof(T));
+        return value;
+    }
+
+    // Выровненный буфер под count значений T для пакетного копирования
+    template <typename T>
+    class RawBuffer {
+        std::allocator<T> alloc;
+        T* storage;
+        size_t count;
+
+    public:
+        explicit RawBuffer(size_t capacity) : storage(alloc.allocate(capacity)), count(capacity) {}
+        RawBuffer(const RawBuffer&) = delete;
+        RawBuffer& operator=(const RawBuffer&) = delete;
+        ~RawBuffer() { alloc.deallocate(storage, count); }
+
+        T* data() const noexcept { return storage; }
+        size_t capacity() const noexcept { return count; }
+    };
+}
+
+// Точка настройки двоичного формата элемента. Специализация должна предоставить
+//   static void write(std::ostream&, const T&);
+//   static T read(std::istream&);
+// Для тривиально копируемых T формат - байты значения в порядке платформы, и
+// SingleLinkedList::save/load копируют элементы сразу блоками (raw_bytes).
+template <typename T, typename Enable = void>
+struct BinarySerializer;
+
+template <typename T>
+struct BinarySerializer<T, std::enable_if_t<std::is_trivially_copyable_v<T>>> {
+    static constexpr bool raw_bytes = true;
+
+    static void write(std::ostream& os, const T& value) {
+        binary_io::write_value(os, value);
+    }
+
+    static T read(std::istream& is) {
+        return binary_io::read_value<T>(is);
+    }
+};
+
+// Строка: длина, затем символы. Длине из потока не доверяем: символы читаются
+// кусками по kReadChunk, так что поддельная длина упирается в конец данных,
+// а не в выделение памяти под всю строку сразу.
+template <>
+struct BinarySerializer<std::string> {
+    static constexpr size_t kReadChunk = 64 * 1024;
+
+    static void write(std::ostream& os, const std::string& value) {
+        binary_io::write_value<uint64_t>(os, value.size());
+        binary_io::write_bytes(os, value.data(), value.size());
+    }
+
+    static std::string read(std::istream& is) {
+        uint64_t length = binary_io::read_value<uint64_t>(is);
+        std::string value;
+        if (length > value.max_size()) {
+            throw std::runtime_error("Serialized string is too long");
+        }
+        while (value.size() < length) {
+            size_t offset = value.size();
+            size_t chunk = static_cast<size_t>(length - offset) < kReadChunk ? static_cast<size_t>(length - offset) : kReadChunk;
+            value.resize(offset + chunk);
+            binary_io::read_bytes(is, value.data() + offset, chunk);
+        }
+        return value;
+    }
+};
+
+namespace binary_serializer_detail {
+    template <typename T, typename = void>
+    struct is_raw : std::false_type {};
+
+    template <typename T>
+    struct is_raw<T, std::enable_if_t<BinarySerializer<T>::raw_bytes>> : std::true_type {};
+}
+
+// true, если элементы T пишутся и читаются простым копированием байтов
+template <typename T>
+inline constexpr bool binary_serializer_is_raw = binary_serializer_detail::is_raw<T>::value;
+
+#endif
@@ -0,0 +1,432 @@
+#ifndef COMPACT_SINGLE_LINKED_LIST_H
+#define COMPACT_SINGLE_LINKED_LIST_H
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <memory_resource>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "list.h"
+
+// Узел со ссылкой-индексом вместо указателя: для int - 8 байт вместо 16
+template <typename T>
+struct CompactNode {
+    T value;
+    uint32_t next;
+};
+
+// Пул узлов, адресуемых 32-битными индексами. Узлы нарезаются из кусков по kChunkNodes,
+// которые запрашиваются у Resource; отдельный узел выделяется и освобождается без обращения
+// к ресурсу - это снятие вершины встроенного списка свободных индексов или сдвиг счётчика.
+// Resource - конкретный тип ресурса, известный при компиляции: если он объявлен final,
+// компилятор может девиртуализировать и встроить его do_allocate.
+template <typename Node, typename Resource>
+class IndexNodePool {
+    static_assert(std::is_base_of_v<std::pmr::memory_resource, Resource>,
+                  "Resource must derive from std::pmr::memory_resource");
+
+public:
+    static constexpr uint32_t kNull = std::numeric_limits<uint32_t>::max();
+    static constexpr unsigned kChunkShift = 10;
+    static constexpr uint32_t kChunkNodes = uint32_t{1} << kChunkShift;
+
+private:
+    Resource* resource;
+    std::pmr::vector<Node*> chunks;
+    uint32_t carved = 0;           // индексы ниже этого уже выдавались
+    uint32_t free_head = kNull;
+
+    void add_chunk() {
+        if (chunks.size() >= (size_t{kNull} >> kChunkShift)) {
+            throw std::length_error("Compact list node index space exhausted");
+        }
+        // Место в массиве резервируется до выделения блока, чтобы push_back не бросил
+        // и блок не потерялся; рост геометрический
+        if (chunks.size() == chunks.capacity()) {
+            chunks.reserve(std::max<size_t>(1, 2 * chunks.size()));
+        }
+        chunks.push_back(static_cast<Node*>(resource->allocate(sizeof(Node) * kChunkNodes, alignof(Node))));
+    }
+
+    void release_chunks() noexcept {
+        for (Node* chunk : chunks) {
+            resource->deallocate(chunk, sizeof(Node) * kChunkNodes, alignof(Node));
+        }
+        chunks.clear();
+    }
+
+public:
+    explicit IndexNodePool(Resource* parent) : resource(parent), chunks(parent) {}
+
+    IndexNodePool(IndexNodePool&& other) noexcept
+        : resource(other.resource), chunks(std::move(other.chunks)),
+          carved(other.carved), free_head(other.free_head) {
+        other.chunks.clear();
+        other.reset();
+    }
+
+    IndexNodePool(const IndexNodePool&) = delete;
+    IndexNodePool& operator=(const IndexNodePool&) = delete;
+    IndexNodePool& operator=(IndexNodePool&&) = delete;
+
+    ~IndexNodePool() {
+        release_chunks();
+    }
+
+    Node& operator[](uint32_t index) noexcept {
+        return chunks[index >> kChunkShift][index & (kChunkNodes - 1)];
+    }
+
+    const Node& operator[](uint32_t index) const noexcept {
+        return chunks[index >> kChunkShift][index & (kChunkNodes - 1)];
+    }
+
+    uint32_t allocate() {
+        if (free_head != kNull) {
+            uint32_t index = free_head;
+            free_head = (*this)[index].next;
+            return index;
+        }
+        if (carved == chunks.size() * size_t{kChunkNodes}) add_chunk();
+        return carved++;
+    }
+
+    void deallocate(uint32_t index) noexcept {
+        (*this)[index].next = free_head;
+        free_head = index;
+    }
+
+    // Все узлы снова свободны; куски остаются за пулом
+    void reset() noexcept {
+        carved = 0;
+        free_head = kNull;
+    }
+
+    // Массивы кусков можно обменять, только если их аллокаторы равны
+    bool same_resource(const IndexNodePool& other) const noexcept {
+        return resource == other.resource || resource->is_equal(*other.resource);
+    }
+
+    // Ресурсы должны совпадать (same_resource)
+    void swap(IndexNodePool& other) noexcept {
+        std::swap(resource, other.resource);
+        chunks.swap(other.chunks);
+        std::swap(carved, other.carved);
+        std::swap(free_head, other.free_head);
+    }
+
+    Resource* get_resource() const noexcept { return resource; }
+    size_t chunk_count() const noexcept { return chunks.size(); }
+};
+
+// Односвязный список тривиально копируемых T с узлами CompactNode<T> в собственном пуле.
+// Узлы меньше, лежат кусками подряд, а выделение узла не вызывает виртуальных функций.
+// clear() за O(1) возвращает все узлы пулу без обхода. Цена - лишняя зависимая загрузка
+// (адрес куска) на каждом шаге обхода, поэтому проход по списку в кэше медленнее, чем у
+// SingleLinkedList. Ограничение - не больше 2^32 - 1 узлов; splice и merge между списками
+// невозможны, потому что индексы относятся к пулу.
+template <typename T, typename Resource = std::pmr::memory_resource>
+class CompactSingleLinkedList {
+    static_assert(std::is_trivially_copyable_v<T>, "CompactSingleLinkedList requires trivially copyable T");
+
+private:
+    using Node = CompactNode<T>;
+    using Pool = IndexNodePool<Node, Resource>;
+    static constexpr uint32_t kNull = Pool::kNull;
+
+    Pool pool;
+    uint32_t head = kNull;
+    size_t list_size = 0;
+
+    static Resource* default_resource() {
+        if constexpr (std::is_same_v<Resource, std::pmr::memory_resource>) {
+            return std::pmr::get_default_resource();
+        } else {
+            throw std::invalid_argument("CompactSingleLinkedList requires a resource");
+        }
+    }
+
+    template <typename... Args>
+    uint32_t create_node(uint32_t next, Args&&... args) {
+        uint32_t index = pool.allocate();
+        Node& node = pool[index];
+        ::new (static_cast<void*>(&node.value)) T(std::forward<Args>(args)...);
+        node.next = next;
+        return index;
+    }
+
+    uint32_t& link_after(uint32_t pos) noexcept {
+        return pos == kNull ? head : pool[pos].next;
+    }
+
+    // Обмен пулами и узлами; ресурсы списков должны совпадать
+    void swap_nodes(CompactSingleLinkedList& other) noexcept {
+        pool.swap(other.pool);
+        std::swap(head, other.head);
+        std::swap(list_size, other.list_size);
+    }
+
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using resource_type = Resource;
+
+    class Iterator {
+        friend class CompactSingleLinkedList;
+        Pool* pool;
+        uint32_t current;
+        Node* node;           // узел current, чтобы не пересчитывать адрес при разыменовании
+
+    public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = T;
+        using reference = T&;
+        using pointer = T*;
+        using iterator_category = std::forward_iterator_tag;
+
+        Iterator(Pool* owner = nullptr, uint32_t index = kNull)
+            : pool(owner), current(index), node(index == kNull ? nullptr : &(*owner)[index]) {}
+
+        reference operator*() const { return node->value; }
+        pointer operator->() const { return &node->value; }
+
+        Iterator& operator++() {
+            if (current != kNull) {
+                current = node->next;
+                node = current == kNull ? nullptr : &(*pool)[current];
+            }
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        bool operator==(const Iterator& other) const { return current == other.current; }
+        bool operator!=(const Iterator& other) const { return !(*this == other); }
+    };
+
+    class ConstIterator {
+        friend class CompactSingleLinkedList;
+        const Pool* pool;
+        uint32_t current;
+        const Node* node;           // узел current, чтобы не пересчитывать адрес при разыменовании
+
+    public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = T;
+        using reference = const T&;
+        using pointer = const T*;
+        using iterator_category = std::forward_iterator_tag;
+
+        ConstIterator(const Pool* owner = nullptr, uint32_t index = kNull)
+            : pool(owner), current(index), node(index == kNull ? nullptr : &(*owner)[index]) {}
+        ConstIterator(const Iterator& it) : pool(it.pool), current(it.current), node(it.node) {}
+
+        reference operator*() const { return node->value; }
+        pointer operator->() const { return &node->value; }
+
+        ConstIterator& operator++() {
+            if (current != kNull) {
+                current = node->next;
+                node = current == kNull ? nullptr : &(*pool)[current];
+            }
+            return *this;
+        }
+
+        ConstIterator operator++(int) {
+            ConstIterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        bool operator==(const ConstIterator& other) const { return current == other.current; }
+        bool operator!=(const ConstIterator& other) const { return !(*this == other); }
+    };
+
+    // Конструкторы
+    explicit CompactSingleLinkedList(Resource* resource = nullptr)
+        : pool(resource ? resource : default_resource()) {}
+
+    template <typename InputIt, typename = std::enable_if_t<std::is_convertible_v<
+                  typename std::iterator_traits<InputIt>::iterator_category, std::input_iterator_tag>>>
+    CompactSingleLinkedList(InputIt first, InputIt last, Resource* resource = nullptr)
+        : CompactSingleLinkedList(resource) {
+        insert_after(before_begin(), first, last);
+    }
+
+    CompactSingleLinkedList(const CompactSingleLinkedList& other)
+        : CompactSingleLinkedList(other.pool.get_resource()) {
+        insert_after(before_begin(), other.begin(), other.end());
+    }
+
+    CompactSingleLinkedList(CompactSingleLinkedList&& other) noexcept
+        : pool(std::move(other.pool)), head(other.head), list_size(other.list_size) {
+        other.head = kNull;
+        other.list_size = 0;
+    }
+
+    CompactSingleLinkedList& operator=(const CompactSingleLinkedList& other) {
+        if (this != &other) {
+            clear();
+            insert_after(before_begin(), other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    // При равных ресурсах пул переходит вместе с узлами, прежний пул уничтожается вместе
+    // с other; иначе элементы копируются в собственный пул, а other очищается
+    CompactSingleLinkedList& operator=(CompactSingleLinkedList&& other) {
+        if (this != &other) {
+            if (pool.same_resource(other.pool)) {
+                clear();
+                swap_nodes(other);
+            } else {
+                *this = static_cast<const CompactSingleLinkedList&>(other);
+                other.clear();
+            }
+        }
+        return *this;
+    }
+
+    // Каждый список сохраняет свой ресурс. При разных ресурсах элементы копируются
+    // в пулы списков (строгая гарантия), при равных - обмениваются пулы за O(1)
+    void swap(CompactSingleLinkedList& other) {
+        if (this == &other) return;
+        if (pool.same_resource(other.pool)) {
+            swap_nodes(other);
+            return;
+        }
+        CompactSingleLinkedList from_other(other.begin(), other.end(), get_resource());
+        CompactSingleLinkedList from_this(begin(), end(), other.get_resource());
+        swap_nodes(from_other);
+        other.swap_nodes(from_this);
+    }
+
+    // Доступ к элементам
+    T& front() {
+        if (head == kNull) throw std::logic_error("List is empty");
+        return pool[head].value;
+    }
+
+    const T& front() const {
+        if (head == kNull) throw std::logic_error("List is empty");
+        return pool[head].value;
+    }
+
+    // Модификаторы
+    void push_front(const T& value) {
+        emplace_front(value);
+    }
+
+    template <typename... Args>
+    T& emplace_front(Args&&... args) {
+        head = create_node(head, std::forward<Args>(args)...);
+        ++list_size;
+        return pool[head].value;
+    }
+
+    void pop_front() {
+        if (head == kNull) throw std::logic_error("List is empty");
+        uint32_t old = head;
+        head = pool[old].next;
+        pool.deallocate(old);
+        --list_size;
+    }
+
+    // Итераторы; before_begin() совпадает с end(), как у SingleLinkedList
+    Iterator before_begin() { return Iterator(&pool, kNull); }
+    ConstIterator before_begin() const { return ConstIterator(&pool, kNull); }
+    Iterator begin() { return Iterator(&pool, head); }
+    Iterator end() { return Iterator(&pool, kNull); }
+    ConstIterator begin() const { return ConstIterator(&pool, head); }
+    ConstIterator end() const { return ConstIterator(&pool, kNull); }
+    ConstIterator cbegin() const { return begin(); }
+    ConstIterator cend() const { return end(); }
+
+    Iterator insert_after(ConstIterator pos, const T& value) {
+        return emplace_after(pos, value);
+    }
+
+    // Вставка диапазона; возвращает итератор на последний вставленный элемент
+    template <typename InputIt, typename = std::enable_if_t<std::is_convertible_v<
+                  typename std::iterator_traits<InputIt>::iterator_category, std::input_iterator_tag>>>
+    Iterator insert_after(ConstIterator pos, InputIt first, InputIt last) {
+        uint32_t last_inserted = pos.current;
+        for (; first != last; ++first) {
+            last_inserted = emplace_after(ConstIterator(&pool, last_inserted), *first).current;
+        }
+        return Iterator(&pool, last_inserted);
+    }
+
+    template <typename... Args>
+    Iterator emplace_after(ConstIterator pos, Args&&... args) {
+        uint32_t index = create_node(kNull, std::forward<Args>(args)...);
+        uint32_t& link = link_after(pos.current);
+        pool[index].next = link;
+        link = index;
+        ++list_size;
+        return Iterator(&pool, index);
+    }
+
+    Iterator erase_after(ConstIterator pos) {
+        if (pos.current == kNull || pool[pos.current].next == kNull) {
+            throw std::logic_error("Invalid iterator for erase_after");
+        }
+        uint32_t& link = pool[pos.current].next;
+        uint32_t erased = link;
+        link = pool[erased].next;
+        pool.deallocate(erased);
+        --list_size;
+        return Iterator(&pool, link);
+    }
+
+    void reverse() noexcept {
+        uint32_t reversed = kNull;
+        while (head != kNull) {
+            uint32_t next = pool[head].next;
+            pool[head].next = reversed;
+            reversed = head;
+            head = next;
+        }
+        head = reversed;
+    }
+
+    // Наблюдатели
+    bool empty() const { return list_size == 0; }
+    size_t size() const { return list_size; }
+
+    // Элементы тривиально разрушаемы, поэтому узлы возвращаются пулу без обхода
+    void clear() noexcept {
+        pool.reset();
+        head = kNull;
+        list_size = 0;
+    }
+
+    Resource* get_resource() const noexcept { return pool.get_resource(); }
+};
+
+template <typename T, typename Resource>
+void swap(CompactSingleLinkedList<T, Resource>& lhs, CompactSingleLinkedList<T, Resource>& rhs) {
+    lhs.swap(rhs);
+}
+
+// Выбор раскладки узла при компиляции: компактные узлы для тривиально копируемых T,
+// для которых они действительно меньше обычного SingleLinkedListNode
+template <typename T>
+inline constexpr bool use_compact_nodes = std::is_trivially_copyable_v<T> &&
+                                          sizeof(CompactNode<T>) < sizeof(SingleLinkedListNode<T>);
+
+template <typename T, typename Resource = std::pmr::memory_resource>
+using AutoSingleLinkedList = std::conditional_t<use_compact_nodes<T>,
+                                                CompactSingleLinkedList<T, Resource>, SingleLinkedList<T>>;
+
+#endif
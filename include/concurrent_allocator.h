@@ -0,0 +1,210 @@
+#ifndef CONCURRENT_MEMORY_RESOURCE_H
+#define CONCURRENT_MEMORY_RESOURCE_H
+
+#include <memory_resource>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <optional>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "allocator.h"
+
+// Потокобезопасный ресурс с кэшами свободных блоков на каждый поток.
+// Маленькие блоки выдаются и принимаются локальным кэшем потока без синхронизации;
+// кэш пополняется и сбрасывается пачками по kBatchSize в общий пул под мьютексом.
+// Блок можно освобождать в любом потоке - он попадает в кэш освобождающего потока.
+class ConcurrentMemoryResource : public std::pmr::memory_resource {
+public:
+    static constexpr size_t kBatchSize = 32;
+    static constexpr size_t kDefaultSlabSize = 64 * 1024;
+
+private:
+    static constexpr size_t kSizeClassCount = CustomMemoryResource::kSizeClassCount;
+
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    struct FreeList {
+        FreeBlock* head = nullptr;
+        size_t count = 0;
+
+        void push(void* ptr) {
+            FreeBlock* block = static_cast<FreeBlock*>(ptr);
+            block->next = head;
+            head = block;
+            ++count;
+        }
+
+        void* pop() {
+            FreeBlock* block = head;
+            head = block->next;
+            --count;
+            return block;
+        }
+    };
+
+    // Общий пул: переживает ресурс, пока на него ссылаются кэши потоков
+    struct Central {
+        std::mutex mutex;
+        std::optional<CustomMemoryResource> pool;
+        FreeList lists[kSizeClassCount];
+        std::atomic<bool> closed{false};
+
+        Central(std::pmr::memory_resource* parent, size_t slab_bytes) {
+            pool.emplace(parent, slab_bytes);
+        }
+
+        // Вызывается под mutex
+        void refill(size_t index, FreeList& target) {
+            size_t moved = 0;
+            for (; moved < kBatchSize && lists[index].head; ++moved) {
+                target.push(lists[index].pop());
+            }
+            size_t class_size = CustomMemoryResource::size_class_size(index);
+            size_t class_alignment = CustomMemoryResource::size_class_alignment(index);
+            for (; moved < kBatchSize; ++moved) {
+                target.push(pool->allocate(class_size, class_alignment));
+            }
+        }
+    };
+
+    struct ThreadCache {
+        uint64_t owner_id;
+        std::shared_ptr<Central> central;
+        FreeList lists[kSizeClassCount];
+
+        ThreadCache(uint64_t id, std::shared_ptr<Central> c) : owner_id(id), central(std::move(c)) {}
+
+        void drain(size_t index, size_t count) {
+            std::lock_guard<std::mutex> lock(central->mutex);
+            for (size_t i = 0; i < count && lists[index].head; ++i) {
+                central->lists[index].push(lists[index].pop());
+            }
+        }
+
+        ThreadCache(const ThreadCache&) = delete;
+        ThreadCache& operator=(const ThreadCache&) = delete;
+
+        // При завершении потока свободные блоки возвращаются в общий пул,
+        // если ресурс ещё жив; иначе их память уже отдана родителю
+        ~ThreadCache() {
+            std::lock_guard<std::mutex> lock(central->mutex);
+            if (central->closed.load(std::memory_order_relaxed)) return;
+            for (size_t index = 0; index < kSizeClassCount; ++index) {
+                while (lists[index].head) {
+                    central->lists[index].push(lists[index].pop());
+                }
+            }
+        }
+    };
+
+    // Кэши текущего потока для всех ресурсов, которыми он пользовался
+    struct ThreadCacheRegistry {
+        std::vector<std::unique_ptr<ThreadCache>> caches;
+        ThreadCache* last = nullptr;
+
+        ThreadCache& get(uint64_t id, const std::shared_ptr<Central>& central) {
+            if (last && last->owner_id == id) return *last;
+            for (auto it = caches.begin(); it != caches.end();) {
+                if ((*it)->owner_id == id) {
+                    last = it->get();
+                    return *last;
+                }
+                // Кэши уничтоженных ресурсов больше не нужны
+                if ((*it)->central->closed.load(std::memory_order_acquire)) {
+                    it = caches.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            caches.push_back(std::make_unique<ThreadCache>(id, central));
+            last = caches.back().get();
+            return *last;
+        }
+    };
+
+    static inline std::atomic<uint64_t> next_id{1};
+
+    uint64_t id;
+    std::shared_ptr<Central> central;
+
+    ThreadCache& local_cache() {
+        static thread_local ThreadCacheRegistry registry;
+        return registry.get(id, central);
+    }
+
+public:
+    explicit ConcurrentMemoryResource(std::pmr::memory_resource* parent = nullptr,
+                                      size_t slab_bytes = kDefaultSlabSize)
+        : id(next_id.fetch_add(1, std::memory_order_relaxed)),
+          central(std::make_shared<Central>(parent, slab_bytes))
+    {}
+
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        size_t index = CustomMemoryResource::size_class_index(bytes, alignment);
+        if (index == kSizeClassCount) {
+            std::lock_guard<std::mutex> lock(central->mutex);
+            return central->pool->allocate(bytes, alignment);
+        }
+
+        FreeList& list = local_cache().lists[index];
+        if (!list.head) {
+            std::lock_guard<std::mutex> lock(central->mutex);
+            central->refill(index, list);
+        }
+        return list.pop();
+    }
+
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override {
+        size_t index = CustomMemoryResource::size_class_index(bytes, alignment);
+        if (index == kSizeClassCount) {
+            std::lock_guard<std::mutex> lock(central->mutex);
+            central->pool->deallocate(ptr, bytes, alignment);
+            return;
+        }
+
+        ThreadCache& cache = local_cache();
+        cache.lists[index].push(ptr);
+        if (cache.lists[index].count > 2 * kBatchSize) {
+            cache.drain(index, kBatchSize);
+        }
+    }
+
+    // Возвращает в пул блоки из общих списков и обрезает пул до max_retained_bytes;
+    // блоки, лежащие в кэшах потоков, не затрагиваются
+    void trim(size_t max_retained_bytes = 0) {
+        std::lock_guard<std::mutex> lock(central->mutex);
+        for (size_t index = 0; index < kSizeClassCount; ++index) {
+            size_t class_size = CustomMemoryResource::size_class_size(index);
+            size_t class_alignment = CustomMemoryResource::size_class_alignment(index);
+            while (central->lists[index].head) {
+                central->pool->deallocate(central->lists[index].pop(), class_size, class_alignment);
+            }
+        }
+        central->pool->trim(max_retained_bytes);
+    }
+
+    // Статистика общего пула: блоки в кэшах потоков в ней числятся выданными
+    CustomMemoryResource::Stats pool_stats() const noexcept {
+        return central->pool->stats();
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    ConcurrentMemoryResource(const ConcurrentMemoryResource&) = delete;
+    ConcurrentMemoryResource& operator=(const ConcurrentMemoryResource&) = delete;
+
+    // Память возвращается родителю сразу; кэши потоков лишь помечаются устаревшими
+    ~ConcurrentMemoryResource() noexcept {
+        std::lock_guard<std::mutex> lock(central->mutex);
+        central->closed.store(true, std::memory_order_release);
+        central->pool.reset();
+    }
+};
+
+#endif
@@ -0,0 +1,169 @@
+#ifndef CONCURRENT_SINGLE_LINKED_LIST_H
+#define CONCURRENT_SINGLE_LINKED_LIST_H
+
+#include <atomic>
+#include <memory>
+#include <memory_resource>
+#include <utility>
+#include <cstddef>
+
+// Lock-free стек (стек Трайбера) с узлами той же формы, что и в SingleLinkedList.
+// push_front и try_pop_front безопасны из любого числа потоков; memory_resource
+// должен быть потокобезопасным (например, ConcurrentMemoryResource).
+//
+// Защита от ABA и от обращения к освобождённому узлу: снятый узел освобождается
+// только когда в try_pop_front нет других потоков, иначе он откладывается в список
+// на удаление. Пока узел не освобождён, его адрес не может вернуться в стек.
+template <typename T>
+class ConcurrentSingleLinkedList {
+private:
+    struct Node {
+        T value;
+        std::atomic<Node*> next;
+
+        template <typename... Args>
+        Node(Node* n, Args&&... args)
+            : value(std::forward<Args>(args)...), next(n) {}
+    };
+
+    using NodeAllocator = std::pmr::polymorphic_allocator<Node>;
+
+    std::atomic<Node*> head{nullptr};
+    std::atomic<size_t> list_size{0};
+    std::atomic<size_t> threads_in_pop{0};
+    std::atomic<Node*> to_be_deleted{nullptr};
+    NodeAllocator alloc;
+
+    template <typename... Args>
+    Node* create_node(Args&&... args) {
+        Node* node = alloc.allocate(1);
+        try {
+            std::allocator_traits<NodeAllocator>::construct(alloc, node, nullptr, std::forward<Args>(args)...);
+            return node;
+        } catch (...) {
+            alloc.deallocate(node, 1);
+            throw;
+        }
+    }
+
+    void destroy_node(Node* node) {
+        std::allocator_traits<NodeAllocator>::destroy(alloc, node);
+        alloc.deallocate(node, 1);
+    }
+
+    void destroy_chain(Node* node) {
+        while (node) {
+            Node* next = node->next.load(std::memory_order_relaxed);
+            destroy_node(node);
+            node = next;
+        }
+    }
+
+    // Счётчик увеличивается до публикации, чтобы снятие узла не могло увести его ниже нуля
+    void publish(Node* node) {
+        list_size.fetch_add(1, std::memory_order_relaxed);
+        Node* expected = head.load(std::memory_order_relaxed);
+        do {
+            node->next.store(expected, std::memory_order_relaxed);
+        } while (!head.compare_exchange_weak(expected, node,
+                                             std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    void chain_pending(Node* first, Node* last) {
+        Node* expected = to_be_deleted.load();
+        do {
+            last->next.store(expected, std::memory_order_relaxed);
+        } while (!to_be_deleted.compare_exchange_weak(expected, first));
+    }
+
+    void chain_pending(Node* nodes) {
+        Node* last = nodes;
+        while (Node* next = last->next.load(std::memory_order_relaxed)) {
+            last = next;
+        }
+        chain_pending(nodes, last);
+    }
+
+    // Освобождение снятого узла и накопленных отложенных узлов
+    void try_reclaim(Node* old_head) {
+        if (threads_in_pop.load() == 1) {
+            Node* nodes = to_be_deleted.exchange(nullptr);
+            if (threads_in_pop.fetch_sub(1) == 1) {
+                destroy_chain(nodes);
+            } else if (nodes) {
+                chain_pending(nodes);
+            }
+            destroy_node(old_head);
+        } else {
+            chain_pending(old_head, old_head);
+            threads_in_pop.fetch_sub(1);
+        }
+    }
+
+public:
+    using value_type = T;
+    using allocator_type = std::pmr::polymorphic_allocator<T>;
+    using size_type = size_t;
+
+    ConcurrentSingleLinkedList() : alloc(std::pmr::get_default_resource()) {}
+
+    explicit ConcurrentSingleLinkedList(std::pmr::memory_resource* resource)
+        : alloc(resource) {}
+
+    explicit ConcurrentSingleLinkedList(const std::pmr::polymorphic_allocator<T>& allocator)
+        : alloc(allocator) {}
+
+    ConcurrentSingleLinkedList(const ConcurrentSingleLinkedList&) = delete;
+    ConcurrentSingleLinkedList& operator=(const ConcurrentSingleLinkedList&) = delete;
+
+    // Деструктор: к этому моменту другие потоки уже не обращаются к стеку
+    ~ConcurrentSingleLinkedList() {
+        destroy_chain(head.load(std::memory_order_relaxed));
+        destroy_chain(to_be_deleted.load(std::memory_order_relaxed));
+    }
+
+    // Модификаторы
+    void push_front(const T& value) {
+        publish(create_node(value));
+    }
+
+    void push_front(T&& value) {
+        publish(create_node(std::move(value)));
+    }
+
+    template <typename... Args>
+    void emplace_front(Args&&... args) {
+        publish(create_node(std::forward<Args>(args)...));
+    }
+
+    // Снимает верхний элемент в out; false, если стек пуст
+    bool try_pop_front(T& out) {
+        threads_in_pop.fetch_add(1);
+        Node* old_head = head.load(std::memory_order_acquire);
+        while (old_head && !head.compare_exchange_weak(old_head, old_head->next.load(std::memory_order_relaxed),
+                                                       std::memory_order_acquire, std::memory_order_acquire)) {
+        }
+        if (!old_head) {
+            threads_in_pop.fetch_sub(1);
+            return false;
+        }
+        list_size.fetch_sub(1, std::memory_order_relaxed);
+        try {
+            out = std::move(old_head->value);
+        } catch (...) {
+            try_reclaim(old_head);
+            throw;
+        }
+        try_reclaim(old_head);
+        return true;
+    }
+
+    // Наблюдатели (мгновенный снимок, при конкурентных изменениях может устареть)
+    bool empty() const { return head.load(std::memory_order_acquire) == nullptr; }
+    size_t size() const { return list_size.load(std::memory_order_relaxed); }
+
+    // Аллокатор
+    allocator_type get_allocator() const { return alloc; }
+};
+
+#endif
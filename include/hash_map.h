@@ -0,0 +1,380 @@
+#ifndef CHAINED_HASH_MAP_H
+#define CHAINED_HASH_MAP_H
+
+#include <memory>
+#include <memory_resource>
+#include <functional>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cstddef>
+#include "batch_resource.h"
+
+// Узел цепочки: рядом со ссылкой на следующий хранится хэш ключа, поэтому при поиске
+// ключи сравниваются только у узлов с совпавшим хэшем, а при перехэшировании хэш
+// не вычисляется заново
+template <typename Key, typename Value>
+struct HashMapNode {
+    HashMapNode* next;
+    size_t hash;
+    std::pair<const Key, Value> value;
+
+    template <typename... Args>
+    HashMapNode(HashMapNode* n, size_t h, Args&&... args)
+        : next(n), hash(h), value(std::forward<Args>(args)...) {}
+};
+
+// Хэш-таблица с цепочками. Узлы всех корзин и массивы корзин берутся у одного
+// memory_resource. Число корзин - степень двойки.
+//
+// Рост инкрементальный: когда load_factor превышает max_load_factor, создаётся
+// таблица вдвое больше, а узлы старой переносятся в неё по rehash_step корзин
+// (не меньше kRehashStep) за каждую изменяющую операцию. Шаг выбирается так,
+// чтобы перенос закончился раньше, чем вставки снова превысят предел; рост во
+// время переноса откладывается до его конца. На время переноса поиск смотрит в
+// обе таблицы, так что ни одна операция не перехэширует всю таблицу сразу
+// (кроме reserve()).
+template <typename Key, typename Value, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+class ChainedHashMap {
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = std::pair<const Key, Value>;
+    using size_type = size_t;
+    using allocator_type = std::pmr::polymorphic_allocator<value_type>;
+
+    static constexpr size_t kRehashStep = 4;
+    static constexpr size_t kMinBuckets = 8;
+    static constexpr size_t kBatchNodes = 64;
+
+private:
+    using Node = HashMapNode<Key, Value>;
+    using NodeAllocator = std::pmr::polymorphic_allocator<Node>;
+    using Buckets = std::pmr::vector<Node*>;
+
+    NodeAllocator alloc;
+    Buckets table;
+    Buckets old_table;         // непуста, пока идёт перенос
+    size_t migrated = 0;       // корзины old_table до этой уже перенесены
+    size_t rehash_step = kRehashStep;
+    size_t element_count = 0;
+    float load_limit = 1.0f;
+    Hash hasher;
+    KeyEqual key_equal;
+
+    static size_t round_buckets(size_t count) noexcept {
+        size_t buckets = kMinBuckets;
+        while (buckets < count) buckets *= 2;
+        return buckets;
+    }
+
+    static Node*& bucket_for(Buckets& buckets, size_t hash) noexcept {
+        return buckets[hash & (buckets.size() - 1)];
+    }
+
+    bool rehashing() const noexcept { return !old_table.empty(); }
+
+    // Ссылка на узел с ключом key в цепочке или на конец цепочки
+    template <typename K>
+    Node** find_link(Node** link, size_t hash, const K& key) const {
+        while (*link && !((*link)->hash == hash && key_equal((*link)->value.first, key))) {
+            link = &(*link)->next;
+        }
+        return link;
+    }
+
+    Node** find_link(size_t hash, const Key& key) {
+        if (rehashing()) {
+            Node** link = find_link(&bucket_for(old_table, hash), hash, key);
+            if (*link) return link;
+        }
+        return find_link(&bucket_for(table, hash), hash, key);
+    }
+
+    // Перенос count корзин старой таблицы в новую
+    void migrate(size_t count) noexcept {
+        for (; count > 0 && migrated < old_table.size(); --count, ++migrated) {
+            Node* node = old_table[migrated];
+            while (node) {
+                Node* next = node->next;
+                Node*& target = bucket_for(table, node->hash);
+                node->next = target;
+                target = node;
+                node = next;
+            }
+            old_table[migrated] = nullptr;
+        }
+        if (migrated == old_table.size()) {
+            Buckets released(old_table.get_allocator());
+            old_table.swap(released);
+            migrated = 0;
+        }
+    }
+
+    void finish_rehash() noexcept {
+        if (rehashing()) migrate(old_table.size());
+    }
+
+    // Новая таблица на buckets корзин; узлы остаются в старой до переноса.
+    // Шаг переноса - столько корзин, чтобы старая таблица опустела за вставки,
+    // которые новая примет до следующего превышения предела.
+    void start_rehash(size_t buckets) {
+        finish_rehash();
+        Buckets grown(buckets, nullptr, table.get_allocator());
+        size_t capacity = static_cast<size_t>(load_limit * static_cast<float>(buckets));
+        size_t headroom = capacity > element_count ? capacity - element_count : 1;
+        size_t step = (table.size() + headroom - 1) / headroom;
+        old_table.swap(table);
+        table.swap(grown);
+        migrated = 0;
+        rehash_step = step > kRehashStep ? step : kRehashStep;
+    }
+
+    // Пока идёт перенос, рост откладывается: иначе пришлось бы доносить старую
+    // таблицу целиком. Обычно сюда не доходит - шаг рассчитан с запасом, - но
+    // предел может уменьшить max_load_factor().
+    void grow_if_needed(size_t count) {
+        if (static_cast<float>(count) > load_limit * static_cast<float>(table.size()) && !rehashing()) {
+            start_rehash(table.size() * 2);
+        }
+    }
+
+    // Узлы всех корзин уничтожаются одним проходом, память возвращается
+    // ресурсу пачками по kBatchNodes независимо от длины отдельных цепочек
+    void destroy_buckets(Buckets& buckets) noexcept {
+        bool discard = discards_deallocations(alloc.resource());
+        void* blocks[kBatchNodes];
+        size_t pending = 0;
+        for (Node*& head : buckets) {
+            for (Node* node = head; node;) {
+                Node* next = node->next;
+                std::allocator_traits<NodeAllocator>::destroy(alloc, node);
+                if (!discard) {
+                    blocks[pending++] = node;
+                    if (pending == kBatchNodes) {
+                        deallocate_batch(alloc.resource(), blocks, pending, sizeof(Node), alignof(Node));
+                        pending = 0;
+                    }
+                }
+                node = next;
+            }
+            head = nullptr;
+        }
+        if (pending) {
+            deallocate_batch(alloc.resource(), blocks, pending, sizeof(Node), alignof(Node));
+        }
+    }
+
+    template <typename... Args>
+    Node* create_node(Node* next, size_t hash, Args&&... args) {
+        Node* node = alloc.allocate(1);
+        try {
+            std::allocator_traits<NodeAllocator>::construct(alloc, node, next, hash, std::forward<Args>(args)...);
+            return node;
+        } catch (...) {
+            alloc.deallocate(node, 1);
+            throw;
+        }
+    }
+
+    template <typename NodePtr, typename F>
+    static void visit(const Buckets& buckets, F& f) {
+        for (NodePtr node : buckets) {
+            for (; node; node = node->next) f(node->value.first, node->value.second);
+        }
+    }
+
+public:
+    explicit ChainedHashMap(std::pmr::memory_resource* resource = nullptr, size_t bucket_count = kMinBuckets,
+                            Hash hash = Hash(), KeyEqual equal = KeyEqual())
+        : alloc(resource ? resource : std::pmr::get_default_resource()),
+          table(round_buckets(bucket_count), nullptr, alloc.resource()),
+          old_table(alloc.resource()),
+          hasher(std::move(hash)), key_equal(std::move(equal)) {}
+
+    // Копия использует тот же ресурс, что и оригинал
+    ChainedHashMap(const ChainedHashMap& other)
+        : ChainedHashMap(other.alloc.resource(), other.element_count, other.hasher, other.key_equal) {
+        load_limit = other.load_limit;
+        other.for_each([&](const Key& key, const Value& value) { emplace(key, value); });
+    }
+
+    ChainedHashMap(ChainedHashMap&& other)
+        : alloc(other.alloc), table(std::move(other.table)), old_table(std::move(other.old_table)),
+          migrated(other.migrated), rehash_step(other.rehash_step), element_count(other.element_count),
+          load_limit(other.load_limit),
+          hasher(std::move(other.hasher)), key_equal(std::move(other.key_equal)) {
+        other.table = Buckets(kMinBuckets, nullptr, alloc.resource());
+        other.old_table.clear();
+        other.migrated = 0;
+        other.element_count = 0;
+    }
+
+    // Присваивание сохраняет собственный ресурс; хэш, сравнение и max_load_factor берутся у other
+    ChainedHashMap& operator=(const ChainedHashMap& other) {
+        if (this != &other) {
+            clear();
+            hasher = other.hasher;
+            key_equal = other.key_equal;
+            load_limit = other.load_limit;
+            reserve(other.element_count);
+            other.for_each([&](const Key& key, const Value& value) { emplace(key, value); });
+        }
+        return *this;
+    }
+
+    // При одинаковых ресурсах узлы переходят без копирования, иначе элементы перемещаются поштучно
+    ChainedHashMap& operator=(ChainedHashMap&& other) {
+        if (this == &other) return *this;
+        clear();
+        if (alloc == other.alloc) {
+            table.swap(other.table);
+            old_table.swap(other.old_table);
+            std::swap(migrated, other.migrated);
+            std::swap(rehash_step, other.rehash_step);
+            std::swap(element_count, other.element_count);
+            std::swap(load_limit, other.load_limit);
+            using std::swap;
+            swap(hasher, other.hasher);
+            swap(key_equal, other.key_equal);
+        } else {
+            hasher = other.hasher;
+            key_equal = other.key_equal;
+            load_limit = other.load_limit;
+            reserve(other.element_count);
+            other.for_each([&](const Key& key, Value& value) { emplace(key, std::move(value)); });
+            other.clear();
+        }
+        return *this;
+    }
+
+    ~ChainedHashMap() {
+        clear();
+    }
+
+    // Вставка, если ключа ещё нет; возвращает значение по ключу и признак вставки
+    template <typename... Args>
+    std::pair<Value&, bool> try_emplace(const Key& key, Args&&... args) {
+        migrate(rehash_step);
+        size_t hash = hasher(key);
+        if (Node* existing = *find_link(hash, key)) {
+            return {existing->value.second, false};
+        }
+        grow_if_needed(element_count + 1);
+        Node*& head = bucket_for(table, hash);
+        head = create_node(head, hash, std::piecewise_construct, std::forward_as_tuple(key),
+                           std::forward_as_tuple(std::forward<Args>(args)...));
+        ++element_count;
+        return {head->value.second, true};
+    }
+
+    template <typename V>
+    std::pair<Value&, bool> emplace(const Key& key, V&& value) {
+        return try_emplace(key, std::forward<V>(value));
+    }
+
+    bool insert(const Key& key, const Value& value) {
+        return try_emplace(key, value).second;
+    }
+
+    // Значение по ключу; отсутствующее создаётся по умолчанию
+    Value& operator[](const Key& key) {
+        return try_emplace(key).first;
+    }
+
+    Value& at(const Key& key) {
+        Value* value = find(key);
+        if (!value) throw std::out_of_range("Key not found");
+        return *value;
+    }
+
+    const Value& at(const Key& key) const {
+        const Value* value = find(key);
+        if (!value) throw std::out_of_range("Key not found");
+        return *value;
+    }
+
+    // Указатель на значение или nullptr
+    Value* find(const Key& key) {
+        Node* node = *find_link(hasher(key), key);
+        return node ? &node->value.second : nullptr;
+    }
+
+    const Value* find(const Key& key) const {
+        return const_cast<ChainedHashMap*>(this)->find(key);
+    }
+
+    bool contains(const Key& key) const {
+        return find(key) != nullptr;
+    }
+
+    bool erase(const Key& key) {
+        migrate(rehash_step);
+        Node** link = find_link(hasher(key), key);
+        Node* node = *link;
+        if (!node) return false;
+        *link = node->next;
+        std::allocator_traits<NodeAllocator>::destroy(alloc, node);
+        alloc.deallocate(node, 1);
+        --element_count;
+        return true;
+    }
+
+    // f(key, value) для каждого элемента в порядке корзин
+    template <typename F>
+    void for_each(F f) {
+        visit<Node*>(old_table, f);
+        visit<Node*>(table, f);
+    }
+
+    template <typename F>
+    void for_each(F f) const {
+        visit<const Node*>(old_table, f);
+        visit<const Node*>(table, f);
+    }
+
+    // Корзин на count элементов без превышения max_load_factor; перенос выполняется сразу
+    void reserve(size_t count) {
+        finish_rehash();
+        size_t buckets = round_buckets(static_cast<size_t>(static_cast<float>(count) / load_limit) + 1);
+        if (buckets > table.size()) {
+            start_rehash(buckets);
+            finish_rehash();
+        }
+    }
+
+    void clear() noexcept {
+        destroy_buckets(old_table);
+        destroy_buckets(table);
+        Buckets released(old_table.get_allocator());
+        old_table.swap(released);
+        migrated = 0;
+        element_count = 0;
+    }
+
+    bool empty() const noexcept { return element_count == 0; }
+    size_t size() const noexcept { return element_count; }
+
+    size_t bucket_count() const noexcept { return table.size(); }
+    bool rehash_in_progress() const noexcept { return rehashing(); }
+
+    // Корзин старой таблицы, ещё не перенесённых в новую
+    size_t rehash_pending() const noexcept { return old_table.size() - migrated; }
+
+    float load_factor() const noexcept {
+        return static_cast<float>(element_count) / static_cast<float>(table.size());
+    }
+
+    float max_load_factor() const noexcept { return load_limit; }
+
+    void max_load_factor(float limit) {
+        if (!(limit > 0.0f)) throw std::invalid_argument("max_load_factor must be positive");
+        load_limit = limit;
+    }
+
+    allocator_type get_allocator() const { return alloc; }
+};
+
+#endif
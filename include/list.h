@@ -6,29 +6,78 @@
 #include <memory>
 #include <type_traits>
 #include <memory_resource>
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include "batch_resource.h"
+#include "binary_serializer.h"
+#include "trace.h"
 
 template <typename T>
-class SingleLinkedList {
+struct SingleLinkedListNode {
+    T value;
+    SingleLinkedListNode* next;
+
+    // Значение конструируется на месте из переданных аргументов
+    template <typename... Args>
+    SingleLinkedListNode(SingleLinkedListNode* n, Args&&... args)
+        : value(std::forward<Args>(args)...), next(n) {}
+};
+
+// Политики хранения: только голова (размер списка как раньше) или голова и хвост
+// для O(1) push_back и присоединения к концу
+struct HeadOnlyPolicy {
+    static constexpr bool tracks_tail = false;
+};
+
+struct TailTrackingPolicy {
+    static constexpr bool tracks_tail = true;
+};
+
+template <typename Node, bool TracksTail>
+struct SingleLinkedListTail {
+    Node* tail = nullptr;
+};
+
+template <typename Node>
+struct SingleLinkedListTail<Node, false> {};
+
+template <typename T, typename Policy = HeadOnlyPolicy>
+class SingleLinkedList : private SingleLinkedListTail<SingleLinkedListNode<T>, Policy::tracks_tail> {
 private:
-    struct Node {
-        T value;
-        Node* next;
+    using Node = SingleLinkedListNode<T>;
+    using TailStorage = SingleLinkedListTail<Node, Policy::tracks_tail>;
 
-        template <typename U>
-        Node(U&& val, Node* n = nullptr)
-            : value(std::forward<U>(val)), next(n) {}
-    };
+    static constexpr bool kTracksTail = Policy::tracks_tail;
 
     using NodeAllocator = std::pmr::polymorphic_allocator<Node>;
 
+    template <typename It>
+    using RequireInputIterator = std::enable_if_t<std::is_convertible_v<
+        typename std::iterator_traits<It>::iterator_category, std::input_iterator_tag>>;
+
+    // Столько узлов запрашивается у ресурса или возвращается ему за одно обращение
+    static constexpr size_t kBatchNodes = 64;
+
+    // Цепочка ещё не вставленных в список узлов
+    struct Chain {
+        Node* first = nullptr;
+        Node* last = nullptr;
+        size_t size = 0;
+    };
+
     Node* head = nullptr;
     size_t list_size = 0;
     NodeAllocator alloc;
 
-    Node* create_node(const T& value, Node* next = nullptr) {
+    template <typename... Args>
+    Node* create_node(Node* next, Args&&... args) {
+        SLL_TRACE_SCOPE(list_trace::Event::ListCreateNode);
         Node* node = alloc.allocate(1);
         try {
-            std::allocator_traits<NodeAllocator>::construct(alloc, node, value, next);
+            std::allocator_traits<NodeAllocator>::construct(alloc, node, next, std::forward<Args>(args)...);
             return node;
         } catch (...) {
             alloc.deallocate(node, 1);
@@ -36,43 +85,220 @@ private:
         }
     }
 
-    Node* create_node(T&& value, Node* next = nullptr) {
-        Node* node = alloc.allocate(1);
-        try {
-            std::allocator_traits<NodeAllocator>::construct(alloc, node, std::move(value), next);
-            return node;
-        } catch (...) {
+    void destroy_node(Node* node) {
+        SLL_TRACE_SCOPE(list_trace::Event::ListDestroyNode);
+        if (node) {
+            std::allocator_traits<NodeAllocator>::destroy(alloc, node);
             alloc.deallocate(node, 1);
-            throw;
         }
     }
 
-    void destroy_node(Node* node) {
-        if (node) {
+    // Уничтожение цепочки: память возвращается ресурсу пачками по kBatchNodes.
+    // Если ресурс не освобождает отдельные блоки (арена), освобождение пропускается,
+    // а для тривиально разрушаемых T цепочка просто забывается без обхода.
+    void destroy_chain(Node* node) {
+        if (!node) return;
+        bool discard = discards_deallocations(alloc.resource());
+        if constexpr (std::is_trivially_destructible_v<T>) {
+            if (discard) return;
+        }
+        void* blocks[kBatchNodes];
+        size_t pending = 0;
+        while (node) {
+            Node* next = node->next;
             std::allocator_traits<NodeAllocator>::destroy(alloc, node);
-            alloc.deallocate(node, 1);
+            if (!discard) {
+                blocks[pending++] = node;
+                if (pending == kBatchNodes) {
+                    deallocate_batch(alloc.resource(), blocks, pending, sizeof(Node), alignof(Node));
+                    pending = 0;
+                }
+            }
+            node = next;
+        }
+        if (pending) {
+            deallocate_batch(alloc.resource(), blocks, pending, sizeof(Node), alignof(Node));
         }
     }
 
     void destroy_all() {
-        while (head) {
-            Node* next = head->next;
-            destroy_node(head);
-            head = next;
-        }
+        destroy_chain(head);
+        head = nullptr;
         list_size = 0;
+        set_tail(nullptr);
+    }
+
+    // Хвост хранится только в режиме TailTrackingPolicy
+    void set_tail(Node* node) noexcept {
+        if constexpr (kTracksTail) {
+            this->tail = node;
+        }
+    }
+
+    // Список без узлов забирает готовую цепочку
+    void adopt_chain(const Chain& chain) noexcept {
+        head = chain.first;
+        list_size = chain.size;
+        set_tail(chain.last);
+    }
+
+    // Список без узлов забирает узлы other, оставляя его пустым
+    void steal_nodes(SingleLinkedList& other) noexcept {
+        head = other.head;
+        list_size = other.list_size;
+        if constexpr (kTracksTail) {
+            this->tail = other.tail;
+            other.tail = nullptr;
+        }
+        other.head = nullptr;
+        other.list_size = 0;
+    }
+
+    // Цепочка из count узлов: память запрашивается у ресурса пачками по kBatchNodes,
+    // construct(node) конструирует очередной узел. При исключении цепочка уничтожается.
+    // fresh - узлы из ещё не использованной памяти ресурса, подряд, если он это умеет.
+    template <typename Construct>
+    Chain build_chain(size_t count, Construct construct, bool fresh = false) {
+        Chain chain;
+        Node** tail = &chain.first;
+        void* slots[kBatchNodes];
+        try {
+            while (chain.size < count) {
+                size_t batch = std::min(kBatchNodes, count - chain.size);
+                if (fresh) {
+                    allocate_fresh_batch(alloc.resource(), slots, batch, sizeof(Node), alignof(Node));
+                } else {
+                    allocate_batch(alloc.resource(), slots, batch, sizeof(Node), alignof(Node));
+                }
+                size_t i = 0;
+                try {
+                    for (; i < batch; ++i) {
+                        Node* node = static_cast<Node*>(slots[i]);
+                        construct(node);
+                        *tail = node;
+                        tail = &node->next;
+                        chain.last = node;
+                        ++chain.size;
+                    }
+                } catch (...) {
+                    for (; i < batch; ++i) {
+                        alloc.deallocate(static_cast<Node*>(slots[i]), 1);
+                    }
+                    throw;
+                }
+            }
+        } catch (...) {
+            *tail = nullptr;
+            destroy_chain(chain.first);
+            throw;
+        }
+        return chain;
+    }
+
+    // Цепочка из элементов диапазона в исходном порядке; однопроходные
+    // диапазоны неизвестной длины выделяются поузлово
+    template <typename InputIt>
+    Chain chain_from_range(InputIt first, InputIt last) {
+        using Category = typename std::iterator_traits<InputIt>::iterator_category;
+        if constexpr (std::is_convertible_v<Category, std::forward_iterator_tag>) {
+            size_t count = static_cast<size_t>(std::distance(first, last));
+            return build_chain(count, [&](Node* node) {
+                std::allocator_traits<NodeAllocator>::construct(alloc, node, nullptr, *first);
+                ++first;
+            });
+        } else {
+            Chain chain;
+            Node** tail = &chain.first;
+            try {
+                for (; first != last; ++first) {
+                    *tail = create_node(nullptr, *first);
+                    chain.last = *tail;
+                    tail = &chain.last->next;
+                    ++chain.size;
+                }
+            } catch (...) {
+                destroy_chain(chain.first);
+                throw;
+            }
+            return chain;
+        }
+    }
+
+    Chain chain_of_copies(size_t count, const T& value) {
+        return build_chain(count, [&](Node* node) {
+            std::allocator_traits<NodeAllocator>::construct(alloc, node, nullptr, value);
+        });
+    }
+
+    // Перенос элементов other в узлы своего аллокатора: значения перемещаются, узлы other
+    // уничтожаются сразу и возвращаются его ресурсу пачками. Если перемещение T бросает,
+    // уже перенесённые элементы остаются в этом списке, остальные - в other.
+    void move_nodes_from(SingleLinkedList& other) {
+        bool discard = discards_deallocations(other.alloc.resource());
+        void* slots[kBatchNodes];
+        void* released[kBatchNodes];
+        size_t pending = 0;
+        Chain chain;
+        Node** tail = &chain.first;
+
+        auto release_pending = [&] {
+            if (pending) {
+                deallocate_batch(other.alloc.resource(), released, pending, sizeof(Node), alignof(Node));
+                pending = 0;
+            }
+        };
+        auto finish = [&] {
+            release_pending();
+            if (!other.head) other.set_tail(nullptr);
+            adopt_chain(chain);
+        };
+
+        while (other.head) {
+            size_t batch = std::min(kBatchNodes, other.list_size);
+            try {
+                allocate_batch(alloc.resource(), slots, batch, sizeof(Node), alignof(Node));
+            } catch (...) {
+                finish();
+                throw;
+            }
+            size_t i = 0;
+            try {
+                for (; i < batch; ++i) {
+                    Node* source = other.head;
+                    Node* node = static_cast<Node*>(slots[i]);
+                    std::allocator_traits<NodeAllocator>::construct(alloc, node, nullptr, std::move(source->value));
+                    *tail = node;
+                    tail = &node->next;
+                    chain.last = node;
+                    ++chain.size;
+
+                    other.head = source->next;
+                    --other.list_size;
+                    std::allocator_traits<NodeAllocator>::destroy(other.alloc, source);
+                    if (!discard) {
+                        released[pending++] = source;
+                        if (pending == kBatchNodes) release_pending();
+                    }
+                }
+            } catch (...) {
+                for (; i < batch; ++i) {
+                    alloc.deallocate(static_cast<Node*>(slots[i]), 1);
+                }
+                finish();
+                throw;
+            }
+        }
+        finish();
     }
 
     // Копирование узлов с другим аллокатором
     void copy_nodes(const SingleLinkedList& other) {
-        Node** current = &head;
         const Node* other_node = other.head;
-        while (other_node) {
-            *current = create_node(other_node->value);
-            current = &((*current)->next);
+        Chain chain = build_chain(other.list_size, [&](Node* node) {
+            std::allocator_traits<NodeAllocator>::construct(alloc, node, nullptr, other_node->value);
             other_node = other_node->next;
-            ++list_size;
-        }
+        });
+        adopt_chain(chain);
     }
 
 public:
@@ -145,6 +371,152 @@ public:
         bool operator!=(const ConstIterator& other) const { return !(*this == other); }
     };
 
+private:
+    // Вставка готовой цепочки после позиции; возвращает последний вставленный узел
+    Iterator link_after(ConstIterator pos, Chain chain) {
+        Node* prev = const_cast<Node*>(pos.current);
+        if (!chain.first) return Iterator(prev);
+        Node*& link = prev ? prev->next : head;
+        chain.last->next = link;
+        link = chain.first;
+        list_size += chain.size;
+        if (!chain.last->next) set_tail(chain.last);
+        return Iterator(chain.last);
+    }
+
+    // Замена содержимого готовой цепочкой
+    void replace_with(const Chain& chain) {
+        destroy_all();
+        adopt_chain(chain);
+    }
+
+    // Ссылка, в которой хранится узел после pos (для before_begin - голова)
+    Node*& link_after_node(const Node* pos) noexcept {
+        return pos ? const_cast<Node*>(pos)->next : head;
+    }
+
+    void require_same_allocator(const SingleLinkedList& other, const char* operation) const {
+        if (alloc != other.alloc) {
+            throw std::logic_error(std::string("Cannot ") + operation + " lists with different allocators");
+        }
+    }
+
+    // Перенос count узлов от узла после before_first до last включительно из other после pos
+    void transfer_after(const Node* pos, SingleLinkedList& other, const Node* before_first,
+                        Node* last, size_t count) noexcept {
+        Node*& source = other.link_after_node(before_first);
+        Node* first = source;
+        source = last->next;
+        if (!source) other.set_tail(const_cast<Node*>(before_first));
+        other.list_size -= count;
+
+        Node*& target = link_after_node(pos);
+        last->next = target;
+        target = first;
+        if (!last->next) set_tail(last);
+        list_size += count;
+    }
+
+    // Слияние отсортированной цепочки b в отсортированную цепочку a; при равенстве первым
+    // идёт узел из a. Если comp бросает, в a остаются все узлы обеих цепочек (порядок не определён).
+    template <typename Compare>
+    static void merge_chains(Node*& a, Node* b, Compare& comp) {
+        Node* result = nullptr;
+        Node** tail = &result;
+        Node* rest = a;
+        try {
+            while (rest && b) {
+                if (comp(b->value, rest->value)) {
+                    *tail = b;
+                    b = b->next;
+                } else {
+                    *tail = rest;
+                    rest = rest->next;
+                }
+                tail = &(*tail)->next;
+            }
+        } catch (...) {
+            *tail = rest;
+            append_chain(tail, b);
+            a = result;
+            throw;
+        }
+        *tail = rest ? rest : b;
+        a = result;
+    }
+
+    // Дописывает цепочку chain в конец цепочки, начинающейся со ссылки link
+    static void append_chain(Node** link, Node* chain) noexcept {
+        while (*link) link = &(*link)->next;
+        *link = chain;
+    }
+
+    // Пересчёт хвоста после переупорядочивания
+    void refresh_tail() noexcept {
+        if constexpr (kTracksTail) {
+            Node* node = head;
+            while (node && node->next) node = node->next;
+            this->tail = node;
+        }
+    }
+
+protected:
+    // Перезапись значений существующих узлов элементами диапазона: выделяются только
+    // недостающие узлы, освобождается только лишний хвост
+    template <typename InputIt>
+    void assign_reusing(InputIt first, InputIt last) {
+        Node* prev = nullptr;
+        Node* node = head;
+        size_t kept = 0;
+        for (; node && first != last; ++first, ++kept) {
+            node->value = *first;
+            prev = node;
+            node = node->next;
+        }
+        if (first != last) {
+            link_after(ConstIterator(prev), chain_from_range(first, last));
+        } else if (node) {
+            link_after_node(prev) = nullptr;
+            list_size = kept;
+            set_tail(prev);
+            destroy_chain(node);
+        }
+    }
+
+private:
+    // Двоичный формат save/load: заголовок, затем элементы
+    static constexpr uint32_t kBinaryMagic = 0x424C4C53; // "SLLB"
+    static constexpr uint32_t kBinaryVersion = 1;
+
+    // Размер элемента 0 означает формат BinarySerializer<T> с переменной длиной записей
+    static constexpr uint32_t kBinaryElementSize = binary_serializer_is_raw<T> ? sizeof(T) : 0;
+
+    // Тривиально копируемые элементы переносятся через буфер примерно в 64 КиБ
+    static constexpr size_t kRawChunkElements = sizeof(T) < 65536 ? 65536 / sizeof(T) : 1;
+
+    void write_binary_header(std::ostream& os) const {
+        binary_io::write_value(os, kBinaryMagic);
+        binary_io::write_value(os, kBinaryVersion);
+        binary_io::write_value(os, kBinaryElementSize);
+        binary_io::write_value(os, uint32_t{0});
+        binary_io::write_value(os, static_cast<uint64_t>(list_size));
+    }
+
+    // Проверяет заголовок и возвращает число элементов
+    static size_t read_binary_header(std::istream& is) {
+        if (binary_io::read_value<uint32_t>(is) != kBinaryMagic ||
+            binary_io::read_value<uint32_t>(is) != kBinaryVersion) {
+            throw std::runtime_error("Not a serialized list");
+        }
+        if (binary_io::read_value<uint32_t>(is) != kBinaryElementSize) {
+            throw std::runtime_error("Serialized list element type does not match");
+        }
+        binary_io::read_value<uint32_t>(is);
+        return static_cast<size_t>(binary_io::read_value<uint64_t>(is));
+    }
+
+public:
+
     // Конструкторы
     SingleLinkedList() : alloc(std::pmr::get_default_resource()) {}
 
@@ -154,6 +526,18 @@ public:
     explicit SingleLinkedList(const std::pmr::polymorphic_allocator<T>& allocator)
         : alloc(allocator) {}
 
+    // Конструктор из диапазона: элементы в исходном порядке
+    template <typename InputIt, typename = RequireInputIterator<InputIt>>
+    SingleLinkedList(InputIt first, InputIt last, const allocator_type& allocator = allocator_type())
+        : alloc(allocator) {
+        adopt_chain(chain_from_range(first, last));
+    }
+
+    SingleLinkedList(size_t count, const T& value, const allocator_type& allocator = allocator_type())
+        : alloc(allocator) {
+        adopt_chain(chain_of_copies(count, value));
+    }
+
     // Конструктор копирования
     SingleLinkedList(const SingleLinkedList& other) 
         : alloc(other.alloc) {
@@ -162,42 +546,49 @@ public:
 
     // Конструктор перемещения
     SingleLinkedList(SingleLinkedList&& other) noexcept
-        : head(other.head), list_size(other.list_size), alloc(other.alloc) {
-        other.head = nullptr;
-        other.list_size = 0;
+        : alloc(other.alloc) {
+        steal_nodes(other);
     }
 
-    // Оператор присваивания копированием
+    // Оператор присваивания копированием: аллокатор не меняется, существующие узлы
+    // получают новые значения на месте, выделяются только недостающие узлы,
+    // освобождается только лишний хвост
     SingleLinkedList& operator=(const SingleLinkedList& other) {
         if (this != &other) {
-            if (alloc == other.alloc) {
+            if constexpr (std::is_copy_assignable_v<T>) {
+                assign_reusing(other.begin(), other.end());
+            } else {
                 destroy_all();
                 copy_nodes(other);
-            } else {
-                //Когда аллокаторы разные, мы не можем просто переиспользовать узлы из other, потому что они выделены в другом пуле памяти.
-                SingleLinkedList temp(other); // Создает полную копию с ПРАВИЛЬНЫМ аллокатором
-                swap(temp);    // Обмениваем содержимое, swap просто меняет указатели head и значения list_size
             }
         }
         return *this;
     }
 
-    SingleLinkedList& operator=(SingleLinkedList&& other) noexcept {
+    // При разных аллокаторах элементы перемещаются в новые узлы своего аллокатора,
+    // а узлы other освобождаются по ходу; other остаётся пустым
+    SingleLinkedList& operator=(SingleLinkedList&& other) {
         if (this != &other) {
+            destroy_all();
             if (alloc == other.alloc) {
-                destroy_all();
-                head = other.head;
-                list_size = other.list_size;
-                other.head = nullptr;
-                other.list_size = 0;
+                steal_nodes(other);
             } else {
-                destroy_all();
-                copy_nodes(other);
+                move_nodes_from(other);
             }
         }
         return *this;
     }
 
+    // Перемещение вместе с аллокатором: список забирает узлы other и его ресурс за O(1),
+    // без обращений к ресурсам. Явная замена аллокатора, которой operator= не делает.
+    void adopt(SingleLinkedList&& other) noexcept {
+        if (this == &other) return;
+        destroy_all();
+        alloc.~NodeAllocator();
+        ::new (static_cast<void*>(&alloc)) NodeAllocator(other.alloc);
+        steal_nodes(other);
+    }
+
     // Деструктор
     ~SingleLinkedList() {
         destroy_all();
@@ -208,6 +599,9 @@ public:
         using std::swap;
         swap(head, other.head);
         swap(list_size, other.list_size);
+        if constexpr (kTracksTail) {
+            swap(this->tail, other.tail);
+        }
     }
 
     // Доступ к элементам
@@ -221,21 +615,89 @@ public:
         return head->value;
     }
 
+    // Последний элемент; только для TailTrackingPolicy
+    T& back() {
+        static_assert(kTracksTail, "back() requires TailTrackingPolicy");
+        if (!head) throw std::logic_error("List is empty");
+        return this->tail->value;
+    }
+
+    const T& back() const {
+        static_assert(kTracksTail, "back() requires TailTrackingPolicy");
+        if (!head) throw std::logic_error("List is empty");
+        return this->tail->value;
+    }
+
+    // Замена содержимого; при исключении список не меняется
+    template <typename InputIt, typename = RequireInputIterator<InputIt>>
+    void assign(InputIt first, InputIt last) {
+        replace_with(chain_from_range(first, last));
+    }
+
+    void assign(size_t count, const T& value) {
+        replace_with(chain_of_copies(count, value));
+    }
+
     // Модификаторы
     void push_front(const T& value) {
-        head = create_node(value, head);
-        ++list_size;
+        emplace_front(value);
     }
 
     void push_front(T&& value) {
-        head = create_node(std::move(value), head);
+        emplace_front(std::move(value));
+    }
+
+    // Конструирует элемент прямо в узле, без временного объекта
+    template <typename... Args>
+    T& emplace_front(Args&&... args) {
+        head = create_node(head, std::forward<Args>(args)...);
+        if (!head->next) set_tail(head);
         ++list_size;
+        return head->value;
+    }
+
+    // Вставка в конец за O(1); только для TailTrackingPolicy
+    void push_back(const T& value) {
+        emplace_back(value);
+    }
+
+    void push_back(T&& value) {
+        emplace_back(std::move(value));
+    }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        static_assert(kTracksTail, "emplace_back() requires TailTrackingPolicy");
+        if (!head) return emplace_front(std::forward<Args>(args)...);
+        Node* node = create_node(nullptr, std::forward<Args>(args)...);
+        this->tail->next = node;
+        this->tail = node;
+        ++list_size;
+        return node->value;
+    }
+
+    // Перенос всех узлов other в конец списка за O(1); аллокаторы должны совпадать
+    void splice_back(SingleLinkedList& other) {
+        static_assert(kTracksTail, "splice_back() requires TailTrackingPolicy");
+        require_same_allocator(other, "splice");
+        if (this == &other || !other.head) return;
+        if (!head) {
+            steal_nodes(other);
+            return;
+        }
+        this->tail->next = other.head;
+        this->tail = other.tail;
+        list_size += other.list_size;
+        other.head = nullptr;
+        other.tail = nullptr;
+        other.list_size = 0;
     }
 
     void pop_front() {
         if (!head) throw std::logic_error("List is empty");
         Node* old = head;
         head = head->next;
+        if (!head) set_tail(nullptr);
         destroy_node(old);
         --list_size;
     }
@@ -254,30 +716,35 @@ public:
 
     // Вставка после позиции
     Iterator insert_after(ConstIterator pos, const T& value) {
-        if (pos.current == nullptr) {
-            // before_begin(): вставка в начало
-            push_front(value);
-            return Iterator(head);
-        }
-        if (!pos.current) {
-            throw std::logic_error("Invalid iterator");
-        }
-        Node* new_node = create_node(value, const_cast<Node*>(pos.current)->next);
-        const_cast<Node*>(pos.current)->next = new_node;
-        ++list_size;
-        return Iterator(new_node);
+        return emplace_after(pos, value);
     }
 
     Iterator insert_after(ConstIterator pos, T&& value) {
+        return emplace_after(pos, std::move(value));
+    }
+
+    // Вставка диапазона или count копий после позиции; возвращает итератор
+    // на последний вставленный элемент (pos, если вставлять нечего)
+    template <typename InputIt, typename = RequireInputIterator<InputIt>>
+    Iterator insert_after(ConstIterator pos, InputIt first, InputIt last) {
+        return link_after(pos, chain_from_range(first, last));
+    }
+
+    Iterator insert_after(ConstIterator pos, size_t count, const T& value) {
+        return link_after(pos, chain_of_copies(count, value));
+    }
+
+    // Конструирует элемент на месте после позиции
+    template <typename... Args>
+    Iterator emplace_after(ConstIterator pos, Args&&... args) {
         if (pos.current == nullptr) {
-            push_front(std::move(value));
+            // before_begin(): вставка в начало
+            emplace_front(std::forward<Args>(args)...);
             return Iterator(head);
         }
-        if (!pos.current) {
-            throw std::logic_error("Invalid iterator");
-        }
-        Node* new_node = create_node(std::move(value), const_cast<Node*>(pos.current)->next);
+        Node* new_node = create_node(const_cast<Node*>(pos.current)->next, std::forward<Args>(args)...);
         const_cast<Node*>(pos.current)->next = new_node;
+        if (!new_node->next) set_tail(new_node);
         ++list_size;
         return Iterator(new_node);
     }
@@ -289,11 +756,266 @@ public:
         }
         Node* to_delete = const_cast<Node*>(pos.current)->next;
         const_cast<Node*>(pos.current)->next = to_delete->next;
+        if (!to_delete->next) set_tail(const_cast<Node*>(pos.current));
         destroy_node(to_delete);
         --list_size;
         return Iterator(const_cast<Node*>(pos.current)->next);
     }
 
+    // Перенос узлов из other без участия аллокатора; аллокаторы должны совпадать.
+    // Весь список other - после pos
+    void splice_after(ConstIterator pos, SingleLinkedList& other) {
+        require_same_allocator(other, "splice");
+        if (this == &other || !other.head) return;
+        Node* last = other.head;
+        while (last->next) last = last->next;
+        transfer_after(pos.current, other, nullptr, last, other.list_size);
+    }
+
+    // Один элемент, следующий за it
+    void splice_after(ConstIterator pos, SingleLinkedList& other, ConstIterator it) {
+        require_same_allocator(other, "splice");
+        Node* node = other.link_after_node(it.current);
+        if (!node || pos.current == it.current || pos.current == node) return;
+        transfer_after(pos.current, other, it.current, node, 1);
+    }
+
+    // Элементы из интервала (first, last)
+    void splice_after(ConstIterator pos, SingleLinkedList& other, ConstIterator first, ConstIterator last) {
+        require_same_allocator(other, "splice");
+        Node* begin = other.link_after_node(first.current);
+        if (begin == last.current) return;
+        Node* end = begin;
+        size_t count = 1;
+        while (end->next != last.current) {
+            end = end->next;
+            ++count;
+        }
+        transfer_after(pos.current, other, first.current, end, count);
+    }
+
+    // Слияние с отсортированным other; устойчиво, other становится пустым
+    void merge(SingleLinkedList& other) {
+        merge(other, std::less<>());
+    }
+
+    template <typename Compare>
+    void merge(SingleLinkedList& other, Compare comp) {
+        require_same_allocator(other, "merge");
+        if (this == &other || !other.head) return;
+        Node* other_nodes = other.head;
+        other.head = nullptr;
+        try {
+            merge_chains(head, other_nodes, comp);
+        } catch (...) {
+            // Все узлы other уже в этом списке; порядок не определён
+            list_size += other.list_size;
+            other.list_size = 0;
+            other.set_tail(nullptr);
+            refresh_tail();
+            throw;
+        }
+        if constexpr (kTracksTail) {
+            // Последним остаётся тот из прежних хвостов, за которым ничего не припаяно
+            if (!this->tail || this->tail->next) this->tail = other.tail;
+            other.tail = nullptr;
+        }
+        list_size += other.list_size;
+        other.list_size = 0;
+    }
+
+    // Сортировка слиянием снизу вверх: bins[i] хранит отсортированную цепочку из 2^i узлов.
+    // Только перестановка указателей next, устойчиво, O(n log n) сравнений.
+    // Если comp бросает, все элементы остаются в списке в неопределённом порядке.
+    void sort() {
+        sort(std::less<>());
+    }
+
+    template <typename Compare>
+    void sort(Compare comp) {
+        if (!head || !head->next) return;
+        Node* bins[64] = {};
+        size_t used = 0;
+        // Цепочка, которая сливается в корзину; перед слиянием переходит в неё,
+        // поэтому каждый узел в любой момент принадлежит ровно одной из head, carry, bins
+        Node* carry = nullptr;
+        try {
+            while (head) {
+                carry = head;
+                head = head->next;
+                carry->next = nullptr;
+                size_t i = 0;
+                for (; i < used && bins[i]; ++i) {
+                    Node* merging = carry;
+                    carry = nullptr;
+                    merge_chains(bins[i], merging, comp);
+                    carry = bins[i];
+                    bins[i] = nullptr;
+                }
+                bins[i] = carry;
+                carry = nullptr;
+                if (i == used) ++used;
+            }
+            for (size_t i = 0; i < used; ++i) {
+                if (!bins[i]) continue;
+                Node* merging = carry;
+                carry = nullptr;
+                merge_chains(bins[i], merging, comp);
+                carry = bins[i];
+                bins[i] = nullptr;
+            }
+        } catch (...) {
+            // Несортированный остаток, сливаемая цепочка и корзины снова собираются в список
+            append_chain(&head, carry);
+            for (size_t i = 0; i < used; ++i) append_chain(&head, bins[i]);
+            refresh_tail();
+            throw;
+        }
+        head = carry;
+        refresh_tail();
+    }
+
+    void reverse() noexcept {
+        set_tail(head);
+        Node* reversed = nullptr;
+        while (head) {
+            Node* next = head->next;
+            head->next = reversed;
+            reversed = head;
+            head = next;
+        }
+        head = reversed;
+    }
+
+    // Удаление подряд идущих равных элементов; возвращает число удалённых
+    size_t unique() {
+        return unique(std::equal_to<>());
+    }
+
+    template <typename BinaryPredicate>
+    size_t unique(BinaryPredicate pred) {
+        if (!head) return 0;
+        size_t removed = 0;
+        Node* kept = head;
+        while (Node* next = kept->next) {
+            if (pred(kept->value, next->value)) {
+                kept->next = next->next;
+                destroy_node(next);
+                --list_size;
+                ++removed;
+            } else {
+                kept = next;
+            }
+        }
+        set_tail(kept);
+        return removed;
+    }
+
+    // Удаление элементов по условию; возвращает число удалённых.
+    // Узлы уничтожаются после обхода, поэтому условие может ссылаться на элемент списка.
+    // Если условие бросает, уже снятые узлы уничтожаются, остальные остаются в списке.
+    template <typename Predicate>
+    size_t remove_if(Predicate pred) {
+        size_t removed = 0;
+        Node* kept = nullptr;
+        Node* garbage = nullptr;
+        Node** link = &head;
+        try {
+            while (Node* node = *link) {
+                if (pred(node->value)) {
+                    *link = node->next;
+                    node->next = garbage;
+                    garbage = node;
+                    ++removed;
+                } else {
+                    kept = node;
+                    link = &node->next;
+                }
+            }
+        } catch (...) {
+            // Хвост не снимался: условие для него ещё не вернуло true
+            list_size -= removed;
+            destroy_chain(garbage);
+            throw;
+        }
+        set_tail(kept);
+        list_size -= removed;
+        destroy_chain(garbage);
+        return removed;
+    }
+
+    size_t remove(const T& value) {
+        return remove_if([&](const T& item) { return item == value; });
+    }
+
+    // Перенос всех узлов в новую память в порядке списка (у CustomMemoryResource в режиме
+    // слабов - подряд идущие слоты), после чего старые узлы освобождаются. Восстанавливает
+    // локальность обхода после долгой череды вставок и удалений. На время переноса память
+    // под узлы нужна вдвое; освободившиеся слабы возвращает родителю trim() ресурса.
+    // Если перемещение T может бросить, значения копируются, и при исключении список не меняется.
+    // Все итераторы и ссылки на элементы становятся недействительными.
+    void compact() {
+        if (!head) return;
+        Node* source = head;
+        Chain chain = build_chain(list_size, [&](Node* node) {
+            std::allocator_traits<NodeAllocator>::construct(alloc, node, nullptr,
+                                                            std::move_if_noexcept(source->value));
+            source = source->next;
+        }, true);
+        Node* old = head;
+        adopt_chain(chain);
+        destroy_chain(old);
+    }
+
+    // Двоичное сохранение через BinarySerializer<T>. Тривиально копируемые T пишутся
+    // блоками байтов в представлении платформы, поэтому такие данные переносимы только
+    // между платформами с тем же порядком байтов и размером T.
+    void save(std::ostream& os) const {
+        write_binary_header(os);
+        if constexpr (binary_serializer_is_raw<T>) {
+            binary_io::RawBuffer<T> buffer(std::min(list_size, kRawChunkElements) + 1);
+            size_t filled = 0;
+            for (const Node* node = head; node; node = node->next) {
+                std::memcpy(static_cast<void*>(buffer.data() + filled), &node->value, sizeof(T));
+                if (++filled == buffer.capacity()) {
+                    binary_io::write_bytes(os, buffer.data(), filled * sizeof(T));
+                    filled = 0;
+                }
+            }
+            if (filled) binary_io::write_bytes(os, buffer.data(), filled * sizeof(T));
+        } else {
+            for (const Node* node = head; node; node = node->next) {
+                BinarySerializer<T>::write(os, node->value);
+            }
+        }
+    }
+
+    // Загрузка данных save(): записи читаются потоком, узлы выделяются пачками.
+    // При ошибке потока или формата бросается runtime_error, и список не меняется.
+    void load(std::istream& is) {
+        size_t count = read_binary_header(is);
+        if constexpr (binary_serializer_is_raw<T>) {
+            binary_io::RawBuffer<T> buffer(std::min(count, kRawChunkElements) + 1);
+            size_t available = 0;
+            size_t position = 0;
+            size_t remaining = count;
+            replace_with(build_chain(count, [&](Node* node) {
+                if (position == available) {
+                    available = std::min(remaining, buffer.capacity());
+                    binary_io::read_bytes(is, buffer.data(), available * sizeof(T));
+                    remaining -= available;
+                    position = 0;
+                }
+                std::allocator_traits<NodeAllocator>::construct(alloc, node, nullptr, buffer.data()[position++]);
+            }));
+        } else {
+            replace_with(build_chain(count, [&](Node* node) {
+                std::allocator_traits<NodeAllocator>::construct(alloc, node, nullptr,
+                                                                BinarySerializer<T>::read(is));
+            }));
+        }
+    }
+
     // Наблюдатели
     bool empty() const { return list_size == 0; }
     size_t size() const { return list_size; }
@@ -306,8 +1028,8 @@ public:
     allocator_type get_allocator() const { return alloc; }
 };
 
-template <typename T>
-void swap(SingleLinkedList<T>& lhs, SingleLinkedList<T>& rhs) noexcept {
+template <typename T, typename Policy>
+void swap(SingleLinkedList<T, Policy>& lhs, SingleLinkedList<T, Policy>& rhs) noexcept {
     lhs.swap(rhs);
 }
 
@@ -0,0 +1,231 @@
+#ifndef MAPPED_FILE_MEMORY_RESOURCE_H
+#define MAPPED_FILE_MEMORY_RESOURCE_H
+
+#if !__has_include(<sys/mman.h>)
+#error "MappedFileMemoryResource requires POSIX mmap"
+#endif
+
+#include <memory_resource>
+#include <stdexcept>
+#include <system_error>
+#include <string>
+#include <new>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "allocator.h"
+
+// Ресурс, нарезающий блоки из отображённого в память файла (MAP_SHARED).
+// Всё состояние распределителя - указатель нарезки и списки свободных блоков - хранится
+// в самом файле смещениями от его начала, поэтому файл можно открыть заново в другом
+// процессе по другому адресу. Данные подгружаются лениво, по страничным промахам.
+//
+// Размер файла задаётся при создании и не растёт; при нехватке места бросается bad_alloc.
+// В заголовке файла есть kRootSlots корневых ячеек: в них приложение хранит смещения
+// своих структур (например, PersistentSingleLinkedList), чтобы найти их после открытия.
+class MappedFileMemoryResource : public std::pmr::memory_resource {
+public:
+    static constexpr size_t kRootSlots = 8;
+    static constexpr uint64_t kMagic = 0x314C4C53504D4D46ULL; // "FMMPSLL1"
+    static constexpr uint32_t kVersion = 1;
+
+private:
+    static constexpr size_t kSizeClassCount = CustomMemoryResource::kSizeClassCount;
+
+    struct FileHeader {
+        uint64_t magic;
+        uint32_t version;
+        uint32_t header_size;
+        uint64_t capacity;
+        uint64_t bump;                          // начало ещё не нарезанной части
+        uint64_t free_lists[kSizeClassCount];   // свободные маленькие блоки по классам
+        uint64_t large_free;                    // свободные большие блоки, первый подходящий
+        uint64_t roots[kRootSlots];
+    };
+
+    // Свободный блок хранит смещение следующего; большой - ещё и свой размер
+    struct FreeBlock {
+        uint64_t next;
+        uint64_t size;
+    };
+
+    static_assert(sizeof(FreeBlock) <= CustomMemoryResource::kMinBlockSize,
+                  "FreeBlock must fit into the smallest size class");
+
+    // Большие блоки выделяются целыми страницами, выровненными по странице
+    static constexpr size_t kPageSize = 4096;
+    static constexpr size_t kDataStart = (sizeof(FileHeader) + 63) & ~size_t{63};
+
+    static constexpr size_t large_block_size(size_t bytes) noexcept {
+        return (bytes + kPageSize - 1) & ~(kPageSize - 1);
+    }
+
+    int fd = -1;
+    char* base = nullptr;
+    size_t mapped_size = 0;
+    bool opened_existing = false;
+
+    FileHeader* header() const noexcept { return reinterpret_cast<FileHeader*>(base); }
+
+    FreeBlock* block_at(uint64_t offset) const noexcept {
+        return reinterpret_cast<FreeBlock*>(base + offset);
+    }
+
+    [[noreturn]] void fail(const char* operation) {
+        int error = errno;
+        close_mapping();
+        throw std::system_error(error, std::generic_category(), operation);
+    }
+
+    void close_mapping() noexcept {
+        if (base) munmap(base, mapped_size);
+        if (fd >= 0) ::close(fd);
+        base = nullptr;
+        fd = -1;
+    }
+
+    uint64_t bump_allocate(size_t bytes, size_t alignment) {
+        FileHeader* file = header();
+        uint64_t offset = (file->bump + alignment - 1) & ~(uint64_t{alignment} - 1);
+        if (offset > file->capacity || bytes > file->capacity - offset) {
+            throw std::bad_alloc();
+        }
+        file->bump = offset + bytes;
+        return offset;
+    }
+
+public:
+    // Открывает существующий файл или создаёт новый на capacity байт.
+    // У существующего файла capacity игнорируется, а заголовок проверяется.
+    MappedFileMemoryResource(const std::string& path, size_t capacity) {
+        fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+        if (fd < 0) fail("open");
+
+        struct stat info;
+        if (fstat(fd, &info) != 0) fail("fstat");
+        opened_existing = info.st_size > 0;
+        if (opened_existing) {
+            mapped_size = static_cast<size_t>(info.st_size);
+            if (mapped_size < kDataStart) {
+                close_mapping();
+                throw std::runtime_error("Mapped file is too small: " + path);
+            }
+        } else {
+            if (capacity < kDataStart) {
+                close_mapping();
+                throw std::invalid_argument("Mapped file capacity is smaller than its header");
+            }
+            mapped_size = capacity;
+            if (ftruncate(fd, static_cast<off_t>(mapped_size)) != 0) fail("ftruncate");
+        }
+
+        void* mapping = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (mapping == MAP_FAILED) fail("mmap");
+        base = static_cast<char*>(mapping);
+
+        FileHeader* file = header();
+        if (opened_existing) {
+            if (file->magic != kMagic || file->version != kVersion ||
+                file->header_size != sizeof(FileHeader) || file->capacity != mapped_size) {
+                close_mapping();
+                throw std::runtime_error("Not a compatible mapped list file: " + path);
+            }
+        } else {
+            *file = FileHeader{};
+            file->magic = kMagic;
+            file->version = kVersion;
+            file->header_size = sizeof(FileHeader);
+            file->capacity = mapped_size;
+            file->bump = kDataStart;
+        }
+    }
+
+    MappedFileMemoryResource(const MappedFileMemoryResource&) = delete;
+    MappedFileMemoryResource& operator=(const MappedFileMemoryResource&) = delete;
+
+    ~MappedFileMemoryResource() noexcept {
+        close_mapping();
+    }
+
+    // true, если файл уже существовал и его содержимое подхвачено
+    bool reopened() const noexcept { return opened_existing; }
+
+    size_t capacity() const noexcept { return mapped_size; }
+    size_t used() const noexcept { return header()->bump; }
+
+    // Перевод между адресами и смещениями; смещение 0 - нулевой указатель
+    uint64_t to_offset(const void* ptr) const noexcept {
+        return ptr ? static_cast<uint64_t>(static_cast<const char*>(ptr) - base) : 0;
+    }
+
+    void* from_offset(uint64_t offset) const noexcept {
+        return offset ? base + offset : nullptr;
+    }
+
+    // Корневые ячейки для смещений структур приложения
+    uint64_t& root(size_t slot) {
+        if (slot >= kRootSlots) throw std::out_of_range("Root slot out of range");
+        return header()->roots[slot];
+    }
+
+    // Синхронная запись изменённых страниц на диск
+    void flush() {
+        if (msync(base, mapped_size, MS_SYNC) != 0) {
+            throw std::system_error(errno, std::generic_category(), "msync");
+        }
+    }
+
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        if (alignment > kPageSize) throw std::bad_alloc();
+        FileHeader* file = header();
+        size_t index = CustomMemoryResource::size_class_index(bytes, alignment);
+
+        if (index < kSizeClassCount) {
+            if (uint64_t offset = file->free_lists[index]) {
+                file->free_lists[index] = block_at(offset)->next;
+                return base + offset;
+            }
+            return base + bump_allocate(CustomMemoryResource::size_class_size(index),
+                                        CustomMemoryResource::size_class_alignment(index));
+        }
+
+        // Большие блоки: свободный блок того же числа страниц или новый
+        size_t size = large_block_size(bytes);
+        uint64_t* link = &file->large_free;
+        while (uint64_t offset = *link) {
+            FreeBlock* block = block_at(offset);
+            if (block->size == size) {
+                *link = block->next;
+                return base + offset;
+            }
+            link = &block->next;
+        }
+        return base + bump_allocate(size, kPageSize);
+    }
+
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override {
+        if (!ptr) return;
+        FileHeader* file = header();
+        uint64_t offset = to_offset(ptr);
+        FreeBlock* block = block_at(offset);
+        size_t index = CustomMemoryResource::size_class_index(bytes, alignment);
+        if (index < kSizeClassCount) {
+            block->next = file->free_lists[index];
+            file->free_lists[index] = offset;
+            return;
+        }
+        block->size = large_block_size(bytes);
+        block->next = file->large_free;
+        file->large_free = offset;
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+#endif
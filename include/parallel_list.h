@@ -0,0 +1,160 @@
+#ifndef PARALLEL_LIST_ALGORITHMS_H
+#define PARALLEL_LIST_ALGORITHMS_H
+
+#include <atomic>
+#include <exception>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cstddef>
+
+// Разбиение списка на участки для параллельного обхода.
+// Строится одним последовательным проходом и остаётся верным, пока список не меняется,
+// поэтому для многократной аналитики по неизменному списку его стоит построить один раз.
+template <typename Iterator>
+struct ListPartition {
+    std::vector<Iterator> starts;
+    std::vector<size_t> counts;
+
+    size_t chunks() const noexcept { return starts.size(); }
+};
+
+// Разбиение на chunks участков примерно равной длины; участки непустые
+template <typename List>
+auto partition_list(List& list, size_t chunks) {
+    using Iterator = decltype(list.begin());
+    ListPartition<Iterator> partition;
+    size_t total = list.size();
+    if (total == 0) return partition;
+    if (chunks == 0) chunks = 1;
+    if (chunks > total) chunks = total;
+
+    partition.starts.reserve(chunks);
+    partition.counts.reserve(chunks);
+    Iterator it = list.begin();
+    for (size_t chunk = 0; chunk < chunks; ++chunk) {
+        size_t count = total / chunks + (chunk < total % chunks ? 1 : 0);
+        partition.starts.push_back(it);
+        partition.counts.push_back(count);
+        if (chunk + 1 < chunks) {
+            for (size_t i = 0; i < count; ++i) ++it;
+        }
+    }
+    return partition;
+}
+
+namespace parallel_list_detail {
+    template <typename T>
+    struct is_partition : std::false_type {};
+
+    template <typename Iterator>
+    struct is_partition<ListPartition<Iterator>> : std::true_type {};
+
+    // Перегрузки для списка не должны перехватывать уже построенное разбиение
+    template <typename List>
+    using RequireList = std::enable_if_t<!is_partition<std::remove_const_t<List>>::value>;
+
+    inline size_t resolve_threads(size_t threads) {
+        if (threads == 0) threads = std::thread::hardware_concurrency();
+        return threads == 0 ? 1 : threads;
+    }
+
+    // Участки разбираются потоками по одному из общего счётчика; первое
+    // исключение из work пробрасывается вызывающему после завершения всех потоков
+    template <typename Work>
+    void run_chunks(size_t chunks, size_t threads, Work& work) {
+        threads = resolve_threads(threads);
+        if (threads > chunks) threads = chunks;
+        if (threads <= 1) {
+            for (size_t chunk = 0; chunk < chunks; ++chunk) work(chunk);
+            return;
+        }
+
+        std::atomic<size_t> next{0};
+        std::atomic<bool> failed{false};
+        std::exception_ptr error;
+        std::mutex error_mutex;
+        auto worker = [&] {
+            for (size_t chunk; !failed.load(std::memory_order_relaxed)
+                               && (chunk = next.fetch_add(1, std::memory_order_relaxed)) < chunks;) {
+                try {
+                    work(chunk);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(error_mutex);
+                    if (!error) error = std::current_exception();
+                    failed.store(true, std::memory_order_relaxed);
+                }
+            }
+        };
+
+        std::vector<std::thread> pool;
+        pool.reserve(threads - 1);
+        try {
+            for (size_t i = 0; i + 1 < threads; ++i) pool.emplace_back(worker);
+        } catch (...) {
+            failed.store(true, std::memory_order_relaxed);
+            for (auto& thread : pool) thread.join();
+            throw;
+        }
+        worker();
+        for (auto& thread : pool) thread.join();
+        if (error) std::rethrow_exception(error);
+    }
+}
+
+// Параллельный f(element) для всех элементов; f вызывается из разных потоков.
+// threads == 0 - по числу аппаратных потоков.
+template <typename Iterator, typename F>
+void parallel_for_each(const ListPartition<Iterator>& partition, F f, size_t threads = 0) {
+    auto work = [&](size_t chunk) {
+        Iterator it = partition.starts[chunk];
+        for (size_t i = 0; i < partition.counts[chunk]; ++i, ++it) {
+            f(*it);
+        }
+    };
+    parallel_list_detail::run_chunks(partition.chunks(), threads, work);
+}
+
+// Разовый обход: разбиение на несколько участков на поток для балансировки
+template <typename List, typename F, typename = parallel_list_detail::RequireList<List>>
+void parallel_for_each(List& list, F f, size_t threads = 0) {
+    size_t workers = parallel_list_detail::resolve_threads(threads);
+    parallel_for_each(partition_list(list, workers * 4), f, workers);
+}
+
+// reduce должна быть ассоциативной и коммутативной: частичные результаты
+// участков сворачиваются с init в порядке участков
+template <typename Iterator, typename T, typename Reduce, typename Transform>
+T parallel_transform_reduce(const ListPartition<Iterator>& partition, T init, Reduce reduce,
+                            Transform transform, size_t threads = 0) {
+    std::vector<std::optional<T>> partials(partition.chunks());
+    auto work = [&](size_t chunk) {
+        Iterator it = partition.starts[chunk];
+        T partial = transform(*it);
+        ++it;
+        for (size_t i = 1; i < partition.counts[chunk]; ++i, ++it) {
+            partial = reduce(std::move(partial), transform(*it));
+        }
+        partials[chunk].emplace(std::move(partial));
+    };
+    parallel_list_detail::run_chunks(partition.chunks(), threads, work);
+
+    for (auto& partial : partials) {
+        init = reduce(std::move(init), std::move(*partial));
+    }
+    return init;
+}
+
+template <typename List, typename T, typename Reduce, typename Transform,
+          typename = parallel_list_detail::RequireList<List>>
+T parallel_transform_reduce(List& list, T init, Reduce reduce, Transform transform, size_t threads = 0) {
+    size_t workers = parallel_list_detail::resolve_threads(threads);
+    return parallel_transform_reduce(partition_list(list, workers * 4), std::move(init),
+                                     reduce, transform, workers);
+}
+
+#endif
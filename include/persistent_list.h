@@ -0,0 +1,247 @@
+#ifndef PERSISTENT_SINGLE_LINKED_LIST_H
+#define PERSISTENT_SINGLE_LINKED_LIST_H
+
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <new>
+#include <cstddef>
+#include <cstdint>
+#include "mapped_resource.h"
+
+// Односвязный список в файле MappedFileMemoryResource. Связи хранятся смещениями
+// от начала файла, а не указателями, поэтому после повторного открытия файла (в том
+// числе по другому адресу) список доступен сразу, без перестроения и перемещения узлов.
+// Список находится по корневой ячейке ресурса; объект списка - лёгкий дескриптор:
+// его уничтожение не трогает узлы, они живут в файле до clear() или pop/erase.
+template <typename T>
+class PersistentSingleLinkedList {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "PersistentSingleLinkedList stores values as raw bytes in the file");
+
+private:
+    struct Node {
+        uint64_t next;
+        T value;
+    };
+
+    // Описание списка в файле; размер и выравнивание T проверяются при открытии
+    struct Root {
+        uint64_t head;
+        uint64_t size;
+        uint64_t value_size;
+        uint64_t value_alignment;
+    };
+
+    MappedFileMemoryResource* resource;
+    Root* root;
+
+    Node* node_at(uint64_t offset) const noexcept {
+        return static_cast<Node*>(resource->from_offset(offset));
+    }
+
+    // Связь, ведущая к элементу после pos; для before_begin() - голова списка
+    uint64_t& link_after(const Node* pos) const noexcept {
+        return pos ? const_cast<Node*>(pos)->next : root->head;
+    }
+
+    template <typename... Args>
+    Node* create_node(uint64_t next, Args&&... args) {
+        void* memory = resource->allocate(sizeof(Node), alignof(Node));
+        Node* node = static_cast<Node*>(memory);
+        try {
+            ::new (static_cast<void*>(&node->value)) T(std::forward<Args>(args)...);
+        } catch (...) {
+            resource->deallocate(memory, sizeof(Node), alignof(Node));
+            throw;
+        }
+        node->next = next;
+        return node;
+    }
+
+    void destroy_node(Node* node) noexcept {
+        resource->deallocate(node, sizeof(Node), alignof(Node));
+    }
+
+public:
+    using value_type = T;
+    using size_type = size_t;
+
+    class Iterator {
+        friend class PersistentSingleLinkedList;
+        const MappedFileMemoryResource* resource;
+        Node* current;
+
+    public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = T;
+        using reference = T&;
+        using pointer = T*;
+        using iterator_category = std::forward_iterator_tag;
+
+        Iterator(const MappedFileMemoryResource* owner = nullptr, Node* node = nullptr)
+            : resource(owner), current(node) {}
+
+        reference operator*() const { return current->value; }
+        pointer operator->() const { return &current->value; }
+
+        Iterator& operator++() {
+            if (current) current = static_cast<Node*>(resource->from_offset(current->next));
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        bool operator==(const Iterator& other) const { return current == other.current; }
+        bool operator!=(const Iterator& other) const { return !(*this == other); }
+    };
+
+    class ConstIterator {
+        friend class PersistentSingleLinkedList;
+        const MappedFileMemoryResource* resource;
+        const Node* current;
+
+    public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = T;
+        using reference = const T&;
+        using pointer = const T*;
+        using iterator_category = std::forward_iterator_tag;
+
+        ConstIterator(const MappedFileMemoryResource* owner = nullptr, const Node* node = nullptr)
+            : resource(owner), current(node) {}
+        ConstIterator(const Iterator& other) : resource(other.resource), current(other.current) {}
+
+        reference operator*() const { return current->value; }
+        pointer operator->() const { return &current->value; }
+
+        ConstIterator& operator++() {
+            if (current) current = static_cast<const Node*>(resource->from_offset(current->next));
+            return *this;
+        }
+
+        ConstIterator operator++(int) {
+            ConstIterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        bool operator==(const ConstIterator& other) const { return current == other.current; }
+        bool operator!=(const ConstIterator& other) const { return !(*this == other); }
+    };
+
+    // Подключается к списку в ячейке slot; если ячейка пуста, создаёт в файле пустой список
+    PersistentSingleLinkedList(MappedFileMemoryResource& file, size_t slot) : resource(&file) {
+        uint64_t& root_offset = file.root(slot);
+        if (root_offset == 0) {
+            root = static_cast<Root*>(file.allocate(sizeof(Root), alignof(Root)));
+            *root = Root{0, 0, sizeof(T), alignof(T)};
+            root_offset = file.to_offset(root);
+            return;
+        }
+        root = static_cast<Root*>(file.from_offset(root_offset));
+        if (root->value_size != sizeof(T) || root->value_alignment != alignof(T)) {
+            throw std::runtime_error("Persistent list element type does not match the file");
+        }
+    }
+
+    T& front() {
+        if (!root->head) throw std::logic_error("List is empty");
+        return node_at(root->head)->value;
+    }
+
+    const T& front() const {
+        if (!root->head) throw std::logic_error("List is empty");
+        return node_at(root->head)->value;
+    }
+
+    void push_front(const T& value) {
+        emplace_front(value);
+    }
+
+    template <typename... Args>
+    T& emplace_front(Args&&... args) {
+        Node* node = create_node(root->head, std::forward<Args>(args)...);
+        root->head = resource->to_offset(node);
+        ++root->size;
+        return node->value;
+    }
+
+    void pop_front() {
+        if (!root->head) throw std::logic_error("List is empty");
+        Node* old_head = node_at(root->head);
+        root->head = old_head->next;
+        destroy_node(old_head);
+        --root->size;
+    }
+
+    // before_begin() совпадает с end(), как у SingleLinkedList
+    Iterator before_begin() noexcept { return Iterator(resource, nullptr); }
+    ConstIterator before_begin() const noexcept { return ConstIterator(resource, nullptr); }
+
+    Iterator begin() noexcept { return Iterator(resource, node_at(root->head)); }
+    Iterator end() noexcept { return Iterator(resource, nullptr); }
+    ConstIterator begin() const noexcept { return ConstIterator(resource, node_at(root->head)); }
+    ConstIterator end() const noexcept { return ConstIterator(resource, nullptr); }
+    ConstIterator cbegin() const noexcept { return begin(); }
+    ConstIterator cend() const noexcept { return end(); }
+
+    Iterator insert_after(ConstIterator pos, const T& value) {
+        return emplace_after(pos, value);
+    }
+
+    template <typename... Args>
+    Iterator emplace_after(ConstIterator pos, Args&&... args) {
+        uint64_t& link = link_after(pos.current);
+        Node* node = create_node(link, std::forward<Args>(args)...);
+        link = resource->to_offset(node);
+        ++root->size;
+        return Iterator(resource, node);
+    }
+
+    // Удаляет элемент после pos; возвращает итератор на следующий за удалённым
+    Iterator erase_after(ConstIterator pos) {
+        if (!pos.current || !pos.current->next) {
+            throw std::logic_error("Invalid iterator for erase_after");
+        }
+        uint64_t& link = link_after(pos.current);
+        Node* to_delete = node_at(link);
+        link = to_delete->next;
+        destroy_node(to_delete);
+        --root->size;
+        return Iterator(resource, node_at(link));
+    }
+
+    // Замена содержимого диапазоном с сохранением порядка
+    template <typename InputIt, typename = std::enable_if_t<std::is_convertible_v<
+                  typename std::iterator_traits<InputIt>::iterator_category, std::input_iterator_tag>>>
+    void assign(InputIt first, InputIt last) {
+        clear();
+        ConstIterator tail = before_begin();
+        for (; first != last; ++first) {
+            tail = emplace_after(tail, *first);
+        }
+    }
+
+    bool empty() const noexcept { return root->head == 0; }
+    size_t size() const noexcept { return static_cast<size_t>(root->size); }
+
+    // Возвращает все узлы в свободные списки файла
+    void clear() noexcept {
+        while (uint64_t offset = root->head) {
+            Node* node = node_at(offset);
+            root->head = node->next;
+            destroy_node(node);
+        }
+        root->size = 0;
+    }
+
+    MappedFileMemoryResource& get_resource() const noexcept { return *resource; }
+};
+
+#endif
@@ -0,0 +1,394 @@
+#ifndef RCU_SINGLE_LINKED_LIST_H
+#define RCU_SINGLE_LINKED_LIST_H
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// Односвязный список для множества читателей и редких изменений (схема RCU с эпохами).
+// Читатель открывает ReadGuard и обходит список без блокировок; писатель создаёт узел
+// целиком и публикует его одной release-записью в head или next, поэтому читатель
+// видит либо старый, либо новый узел, но не частично построенный.
+//
+// Снятый узел не освобождается сразу: он помечается текущей эпохой и ждёт, пока не
+// закроются все ReadGuard, открытые до его снятия (период ожидания). Освобождение
+// идёт через memory_resource списка. Изменения сериализуются мьютексом писателя,
+// и к ресурсу обращается только писатель, так что ресурс может быть непотокобезопасным
+// (например, CustomMemoryResource).
+template <typename T>
+class RcuSingleLinkedList {
+public:
+    using value_type = T;
+    using allocator_type = std::pmr::polymorphic_allocator<T>;
+    using size_type = size_t;
+
+    static constexpr size_t kMaxReaders = 64;       // одновременно открытых ReadGuard
+    static constexpr size_t kReclaimThreshold = 64; // отложенных узлов до попытки освобождения
+
+private:
+    struct Node {
+        std::atomic<Node*> next;
+        T value;
+
+        template <typename... Args>
+        Node(Node* n, Args&&... args)
+            : next(n), value(std::forward<Args>(args)...) {}
+    };
+
+    using NodeAllocator = std::pmr::polymorphic_allocator<Node>;
+
+    // Эпоха, в которой читатель открыл ReadGuard; 0 - ячейка свободна
+    struct alignas(64) ReaderSlot {
+        std::atomic<uint64_t> epoch{0};
+    };
+
+    // Снятый узел (whole_chain = false) или целая снятая цепочка до nullptr
+    struct Retired {
+        Node* node;
+        uint64_t epoch;
+        bool whole_chain;
+    };
+
+    std::atomic<Node*> head{nullptr};
+    std::atomic<size_t> list_size{0};
+    std::atomic<uint64_t> global_epoch{1};
+    std::array<ReaderSlot, kMaxReaders> readers;
+    std::mutex writer_mutex;
+    std::pmr::vector<Retired> retired;
+    NodeAllocator alloc;
+
+    template <typename... Args>
+    Node* create_node(Node* next, Args&&... args) {
+        Node* node = alloc.allocate(1);
+        try {
+            std::allocator_traits<NodeAllocator>::construct(alloc, node, next, std::forward<Args>(args)...);
+            return node;
+        } catch (...) {
+            alloc.deallocate(node, 1);
+            throw;
+        }
+    }
+
+    void destroy_node(Node* node) noexcept {
+        std::allocator_traits<NodeAllocator>::destroy(alloc, node);
+        alloc.deallocate(node, 1);
+    }
+
+    void destroy_chain(Node* node) noexcept {
+        while (node) {
+            Node* next = node->next.load(std::memory_order_relaxed);
+            destroy_node(node);
+            node = next;
+        }
+    }
+
+    void release(const Retired& entry) noexcept {
+        if (entry.whole_chain) {
+            destroy_chain(entry.node);
+        } else {
+            destroy_node(entry.node);
+        }
+    }
+
+    size_t acquire_slot() noexcept {
+        size_t start = std::hash<std::thread::id>()(std::this_thread::get_id()) % kMaxReaders;
+        for (;;) {
+            uint64_t epoch = global_epoch.load();
+            for (size_t i = 0; i < kMaxReaders; ++i) {
+                size_t slot = (start + i) % kMaxReaders;
+                uint64_t expected = 0;
+                if (readers[slot].epoch.compare_exchange_strong(expected, epoch)) {
+                    // Пара к барьеру в reclaim_locked: либо писатель увидит эту ячейку,
+                    // либо последующее чтение head увидит снятие узла
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    return slot;
+                }
+            }
+            std::this_thread::yield();
+        }
+    }
+
+    // Наименьшая эпоха открытых ReadGuard; UINT64_MAX, если читателей нет
+    uint64_t oldest_reader() const noexcept {
+        uint64_t oldest = UINT64_MAX;
+        for (const ReaderSlot& slot : readers) {
+            uint64_t epoch = slot.epoch.load();
+            if (epoch != 0 && epoch < oldest) oldest = epoch;
+        }
+        return oldest;
+    }
+
+    // Место под запись заранее, чтобы после снятия узла retire не мог бросить
+    void reserve_retired(size_t count) {
+        retired.reserve(retired.size() + count);
+    }
+
+    // Вызывается под writer_mutex после снятия узла из списка
+    void retire(Node* node, bool whole_chain) noexcept {
+        retired.push_back(Retired{node, global_epoch.load(), whole_chain});
+    }
+
+    // Узлы, снятые в эпоху e, свободны, когда все читатели открыты в эпоху больше e.
+    // Эпоха увеличивается, чтобы новые читатели отличались от тех, кто мог видеть узлы.
+    size_t reclaim_locked() noexcept {
+        global_epoch.fetch_add(1);
+        // Записи head/next писателя (release) упорядочиваются до просмотра ячеек читателей
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        uint64_t oldest = oldest_reader();
+        size_t kept = 0;
+        size_t freed = 0;
+        for (const Retired& entry : retired) {
+            if (entry.epoch < oldest) {
+                release(entry);
+                ++freed;
+            } else {
+                retired[kept++] = entry;
+            }
+        }
+        retired.resize(kept);
+        return freed;
+    }
+
+    void maybe_reclaim() noexcept {
+        if (retired.size() >= kReclaimThreshold) reclaim_locked();
+    }
+
+public:
+    class ReadGuard;
+
+    // Итератор читателя; действителен, пока открыт ReadGuard, из которого он получен
+    class ConstIterator {
+        friend class RcuSingleLinkedList;
+        const Node* current;
+
+        explicit ConstIterator(const Node* node) : current(node) {}
+
+    public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = T;
+        using reference = const T&;
+        using pointer = const T*;
+        using iterator_category = std::forward_iterator_tag;
+
+        ConstIterator() : current(nullptr) {}
+
+        reference operator*() const { return current->value; }
+        pointer operator->() const { return &current->value; }
+
+        ConstIterator& operator++() {
+            if (current) current = current->next.load(std::memory_order_acquire);
+            return *this;
+        }
+
+        ConstIterator operator++(int) {
+            ConstIterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        bool operator==(const ConstIterator& other) const { return current == other.current; }
+        bool operator!=(const ConstIterator& other) const { return !(*this == other); }
+    };
+
+    // Секция чтения: пока объект жив, узлы, видимые через него, не освобождаются.
+    // Содержимое - состояние списка на момент обхода; изменения писателя, сделанные
+    // во время обхода, могут быть видны или нет, но каждый элемент цел.
+    class ReadGuard {
+        friend class RcuSingleLinkedList;
+        RcuSingleLinkedList* owner;
+        size_t slot;
+
+        explicit ReadGuard(RcuSingleLinkedList* list) : owner(list), slot(list->acquire_slot()) {}
+
+    public:
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+
+        ReadGuard(ReadGuard&& other) noexcept : owner(other.owner), slot(other.slot) {
+            other.owner = nullptr;
+        }
+
+        ReadGuard& operator=(ReadGuard&&) = delete;
+
+        ~ReadGuard() {
+            if (owner) owner->readers[slot].epoch.store(0, std::memory_order_release);
+        }
+
+        ConstIterator begin() const { return ConstIterator(owner->head.load(std::memory_order_acquire)); }
+        ConstIterator end() const { return ConstIterator(); }
+
+        bool empty() const { return begin() == end(); }
+    };
+
+    RcuSingleLinkedList() : RcuSingleLinkedList(std::pmr::get_default_resource()) {}
+
+    explicit RcuSingleLinkedList(std::pmr::memory_resource* resource)
+        : retired(resource), alloc(resource) {}
+
+    explicit RcuSingleLinkedList(const std::pmr::polymorphic_allocator<T>& allocator)
+        : RcuSingleLinkedList(allocator.resource()) {}
+
+    RcuSingleLinkedList(const RcuSingleLinkedList&) = delete;
+    RcuSingleLinkedList& operator=(const RcuSingleLinkedList&) = delete;
+
+    // Деструктор: к этому моменту ReadGuard уже закрыты
+    ~RcuSingleLinkedList() {
+        for (const Retired& entry : retired) release(entry);
+        destroy_chain(head.load(std::memory_order_relaxed));
+    }
+
+    // Открывает секцию чтения; безопасно из любого числа потоков
+    ReadGuard read() { return ReadGuard(this); }
+
+    // Модификаторы; сериализуются между собой, читателей не блокируют
+    void push_front(const T& value) {
+        emplace_front(value);
+    }
+
+    void push_front(T&& value) {
+        emplace_front(std::move(value));
+    }
+
+    template <typename... Args>
+    void emplace_front(Args&&... args) {
+        std::lock_guard<std::mutex> lock(writer_mutex);
+        Node* node = create_node(head.load(std::memory_order_relaxed), std::forward<Args>(args)...);
+        head.store(node, std::memory_order_release);
+        list_size.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void pop_front() {
+        std::lock_guard<std::mutex> lock(writer_mutex);
+        Node* old_head = head.load(std::memory_order_relaxed);
+        if (!old_head) throw std::logic_error("List is empty");
+        reserve_retired(1);
+        head.store(old_head->next.load(std::memory_order_relaxed), std::memory_order_release);
+        list_size.fetch_sub(1, std::memory_order_relaxed);
+        retire(old_head, false);
+        maybe_reclaim();
+    }
+
+    // Заменяет первый элемент, для которого pred(element) истинно, элементом из args:
+    // новый узел встаёт на место старого одной записью. false, если такого элемента нет.
+    template <typename Pred, typename... Args>
+    bool replace_first(Pred pred, Args&&... args) {
+        std::lock_guard<std::mutex> lock(writer_mutex);
+        std::atomic<Node*>* link = &head;
+        Node* node = link->load(std::memory_order_relaxed);
+        while (node && !pred(std::as_const(node->value))) {
+            link = &node->next;
+            node = link->load(std::memory_order_relaxed);
+        }
+        if (!node) return false;
+        reserve_retired(1);
+        Node* replacement = create_node(node->next.load(std::memory_order_relaxed), std::forward<Args>(args)...);
+        link->store(replacement, std::memory_order_release);
+        retire(node, false);
+        maybe_reclaim();
+        return true;
+    }
+
+    // Удаляет все элементы, для которых pred(element) истинно; возвращает их число
+    template <typename Pred>
+    size_t remove_if(Pred pred) {
+        std::lock_guard<std::mutex> lock(writer_mutex);
+        size_t removed = 0;
+        std::atomic<Node*>* link = &head;
+        while (Node* node = link->load(std::memory_order_relaxed)) {
+            if (!pred(std::as_const(node->value))) {
+                link = &node->next;
+                continue;
+            }
+            reserve_retired(1);
+            link->store(node->next.load(std::memory_order_relaxed), std::memory_order_release);
+            list_size.fetch_sub(1, std::memory_order_relaxed);
+            retire(node, false);
+            ++removed;
+        }
+        maybe_reclaim();
+        return removed;
+    }
+
+    // Новое содержимое строится целиком и публикуется одной записью в head;
+    // читатель видит либо старый список, либо новый
+    template <typename InputIt, typename = std::enable_if_t<std::is_convertible_v<
+                  typename std::iterator_traits<InputIt>::iterator_category, std::input_iterator_tag>>>
+    void assign(InputIt first, InputIt last) {
+        Node* chain = nullptr;
+        std::atomic<Node*>* tail = nullptr;
+        size_t count = 0;
+        std::lock_guard<std::mutex> lock(writer_mutex);
+        try {
+            for (; first != last; ++first, ++count) {
+                Node* node = create_node(nullptr, *first);
+                if (tail) {
+                    tail->store(node, std::memory_order_relaxed);
+                } else {
+                    chain = node;
+                }
+                tail = &node->next;
+            }
+            reserve_retired(1);
+        } catch (...) {
+            destroy_chain(chain);
+            throw;
+        }
+        Node* old_chain = head.exchange(chain, std::memory_order_acq_rel);
+        list_size.store(count, std::memory_order_relaxed);
+        if (old_chain) retire(old_chain, true);
+        maybe_reclaim();
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(writer_mutex);
+        reserve_retired(1);
+        Node* old_chain = head.exchange(nullptr, std::memory_order_acq_rel);
+        list_size.store(0, std::memory_order_relaxed);
+        if (old_chain) retire(old_chain, true);
+        maybe_reclaim();
+    }
+
+    // Освобождает отложенные узлы, которые уже не видит ни один читатель;
+    // не ждёт. Возвращает число освобождённых записей (узлов или цепочек).
+    size_t reclaim() {
+        std::lock_guard<std::mutex> lock(writer_mutex);
+        return reclaim_locked();
+    }
+
+    // Ждёт окончания периода ожидания и освобождает все отложенные узлы.
+    // Нельзя вызывать из потока, у которого открыт ReadGuard этого списка.
+    void synchronize() {
+        std::lock_guard<std::mutex> lock(writer_mutex);
+        uint64_t target = global_epoch.fetch_add(1);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        while (oldest_reader() <= target) {
+            std::this_thread::yield();
+        }
+        reclaim_locked();
+    }
+
+    // Наблюдатели (мгновенный снимок, при конкурентных изменениях может устареть)
+    bool empty() const { return head.load(std::memory_order_acquire) == nullptr; }
+    size_t size() const { return list_size.load(std::memory_order_relaxed); }
+
+    // Число отложенных записей, ожидающих периода ожидания
+    size_t retired_count() {
+        std::lock_guard<std::mutex> lock(writer_mutex);
+        return retired.size();
+    }
+
+    allocator_type get_allocator() const { return alloc; }
+};
+
+#endif
@@ -0,0 +1,208 @@
+#ifndef SMALL_SINGLE_LINKED_LIST_H
+#define SMALL_SINGLE_LINKED_LIST_H
+
+#include <memory_resource>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+#include "list.h"
+
+// Ресурс с N блоками внутри самого объекта. Блоки не больше BlockSize выдаются из
+// встроенного буфера, пока в нём есть место; остальные запросы уходят в upstream.
+template <size_t BlockSize, size_t BlockAlignment, size_t N>
+class InlineBlockResource : public std::pmr::memory_resource {
+private:
+    struct FreeSlot {
+        FreeSlot* next;
+    };
+
+    static constexpr size_t kSlotSize = BlockSize < sizeof(FreeSlot) ? sizeof(FreeSlot) : BlockSize;
+    static constexpr size_t kSlotAlignment = BlockAlignment < alignof(FreeSlot) ? alignof(FreeSlot) : BlockAlignment;
+
+    alignas(kSlotAlignment) unsigned char buffer[N * kSlotSize];
+    size_t bumped = 0;
+    FreeSlot* free_slots = nullptr;
+    std::pmr::memory_resource* upstream;
+
+    bool owns(const void* ptr) const noexcept {
+        auto address = reinterpret_cast<uintptr_t>(ptr);
+        auto begin = reinterpret_cast<uintptr_t>(buffer);
+        return address >= begin && address < begin + sizeof(buffer);
+    }
+
+public:
+    explicit InlineBlockResource(std::pmr::memory_resource* parent = nullptr)
+        : upstream(parent ? parent : std::pmr::get_default_resource()) {}
+
+    InlineBlockResource(const InlineBlockResource&) = delete;
+    InlineBlockResource& operator=(const InlineBlockResource&) = delete;
+
+    std::pmr::memory_resource* upstream_resource() const noexcept { return upstream; }
+
+    // Число свободных встроенных блоков
+    size_t inline_available() const noexcept {
+        size_t count = N - bumped;
+        for (FreeSlot* slot = free_slots; slot; slot = slot->next) ++count;
+        return count;
+    }
+
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        if (bytes <= kSlotSize && alignment <= kSlotAlignment) {
+            if (FreeSlot* slot = free_slots) {
+                free_slots = slot->next;
+                return slot;
+            }
+            if (bumped < N) {
+                return buffer + kSlotSize * bumped++;
+            }
+        }
+        return upstream->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override {
+        if (owns(ptr)) {
+            FreeSlot* slot = static_cast<FreeSlot*>(ptr);
+            slot->next = free_slots;
+            free_slots = slot;
+            return;
+        }
+        upstream->deallocate(ptr, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+namespace small_list_detail {
+    // Встроенный ресурс должен быть создан раньше списка, который на него ссылается
+    template <typename T, size_t N>
+    struct InlineNodes {
+        using Node = SingleLinkedListNode<T>;
+        InlineBlockResource<sizeof(Node), alignof(Node), N> inline_nodes;
+
+        explicit InlineNodes(std::pmr::memory_resource* upstream) : inline_nodes(upstream) {}
+    };
+}
+
+// SingleLinkedList, первые N узлов которого лежат внутри самого объекта: короткие
+// списки не обращаются к upstream-ресурсу вовсе, длинные берут у него узлы сверх N.
+// Копирование и перемещение переносят элементы поштучно (как у small_vector), потому что
+// встроенные узлы нельзя передать другому объекту; у копии тот же upstream, что у оригинала.
+// Аллокатор у каждого списка свой, поэтому splice, merge и compact не предоставляются.
+template <typename T, size_t N = 8, typename Policy = HeadOnlyPolicy>
+class SmallSingleLinkedList : private small_list_detail::InlineNodes<T, N>,
+                              private SingleLinkedList<T, Policy> {
+private:
+    using Storage = small_list_detail::InlineNodes<T, N>;
+    using Base = SingleLinkedList<T, Policy>;
+
+public:
+    using typename Base::value_type;
+    using typename Base::allocator_type;
+    using typename Base::size_type;
+    using typename Base::Iterator;
+    using typename Base::ConstIterator;
+
+    static constexpr size_t inline_capacity = N;
+
+    explicit SmallSingleLinkedList(std::pmr::memory_resource* upstream = nullptr)
+        : Storage(upstream), Base(&this->inline_nodes) {}
+
+    template <typename InputIt, typename = std::enable_if_t<std::is_convertible_v<
+                  typename std::iterator_traits<InputIt>::iterator_category, std::input_iterator_tag>>>
+    SmallSingleLinkedList(InputIt first, InputIt last, std::pmr::memory_resource* upstream = nullptr)
+        : SmallSingleLinkedList(upstream) {
+        this->assign_reusing(first, last);
+    }
+
+    SmallSingleLinkedList(const SmallSingleLinkedList& other)
+        : SmallSingleLinkedList(other.upstream_resource()) {
+        this->assign_reusing(other.begin(), other.end());
+    }
+
+    SmallSingleLinkedList(SmallSingleLinkedList&& other)
+        : SmallSingleLinkedList(other.upstream_resource()) {
+        this->assign_reusing(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+        other.clear();
+    }
+
+    SmallSingleLinkedList& operator=(const SmallSingleLinkedList& other) {
+        if (this != &other) {
+            this->assign_reusing(other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    SmallSingleLinkedList& operator=(SmallSingleLinkedList&& other) {
+        if (this != &other) {
+            this->assign_reusing(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+            other.clear();
+        }
+        return *this;
+    }
+
+    // Поэлементный обмен через временный список
+    void swap(SmallSingleLinkedList& other) {
+        if (this == &other) return;
+        SmallSingleLinkedList temp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(temp);
+    }
+
+    std::pmr::memory_resource* upstream_resource() const noexcept {
+        return this->inline_nodes.upstream_resource();
+    }
+
+    // Сколько из первых N узлов ещё свободно
+    size_t inline_available() const noexcept {
+        return this->inline_nodes.inline_available();
+    }
+
+    // Замена содержимого переиспользует узлы, чтобы не выходить за встроенный буфер
+    template <typename InputIt, typename = std::enable_if_t<std::is_convertible_v<
+                  typename std::iterator_traits<InputIt>::iterator_category, std::input_iterator_tag>>>
+    void assign(InputIt first, InputIt last) {
+        this->assign_reusing(first, last);
+    }
+
+    void assign(size_t count, const T& value) {
+        Base::clear();
+        Base::insert_after(Base::before_begin(), count, value);
+    }
+
+    // Интерфейс SingleLinkedList
+    using Base::front;
+    using Base::back;
+    using Base::push_front;
+    using Base::emplace_front;
+    using Base::push_back;
+    using Base::emplace_back;
+    using Base::pop_front;
+    using Base::before_begin;
+    using Base::begin;
+    using Base::cbegin;
+    using Base::end;
+    using Base::cend;
+    using Base::insert_after;
+    using Base::emplace_after;
+    using Base::erase_after;
+    using Base::sort;
+    using Base::reverse;
+    using Base::unique;
+    using Base::remove_if;
+    using Base::remove;
+    using Base::empty;
+    using Base::size;
+    using Base::clear;
+    using Base::get_allocator;
+};
+
+template <typename T, size_t N, typename Policy>
+void swap(SmallSingleLinkedList<T, N, Policy>& lhs, SmallSingleLinkedList<T, N, Policy>& rhs) {
+    lhs.swap(rhs);
+}
+
+#endif
@@ -0,0 +1,279 @@
+#ifndef SORTED_SINGLE_LINKED_LIST_H
+#define SORTED_SINGLE_LINKED_LIST_H
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cstddef>
+#include "list.h"
+
+// Отсортированный по Compare SingleLinkedList с разреженным индексом: массив указателей
+// на первые узлы участков примерно по kStride узлов. lower_bound/find ищут участок
+// бинарным поиском по индексу и проходят не больше 2 * kStride узлов, то есть за
+// O(log n + kStride). Узлы списка остаются обычными SingleLinkedListNode.
+// Индекс поддерживается вставкой и удалением: участок длиннее 2 * kStride делится,
+// соседние участки суммарно не длиннее kStride сливаются.
+//
+// Элементы доступны только на чтение, чтобы изменение значения не нарушило порядок.
+// Compare может быть прозрачным: тогда поиск принимает ключ другого типа
+// (например, id для элементов Person), если comp(element, key) и comp(key, element) определены.
+template <typename T, typename Compare = std::less<T>, typename Policy = HeadOnlyPolicy>
+class SortedSingleLinkedList {
+public:
+    using List = SingleLinkedList<T, Policy>;
+    using value_type = T;
+    using allocator_type = typename List::allocator_type;
+    using size_type = size_t;
+    using ConstIterator = typename List::ConstIterator;
+
+    static constexpr size_t kStride = 32;
+
+private:
+    // Участок: первый узел и число узлов до начала следующего участка
+    struct Segment {
+        ConstIterator first;
+        size_t count;
+    };
+
+    List list;
+    std::pmr::vector<Segment> index;
+    Compare comp;
+
+    // Первый участок, начало которого не меньше key (upper = false) или больше key (upper = true)
+    template <typename Key>
+    size_t find_segment(const Key& key, bool upper) const {
+        auto it = upper
+            ? std::upper_bound(index.begin(), index.end(), key,
+                               [&](const Key& k, const Segment& s) { return comp(k, *s.first); })
+            : std::lower_bound(index.begin(), index.end(), key,
+                               [&](const Segment& s, const Key& k) { return comp(*s.first, k); });
+        return static_cast<size_t>(it - index.begin());
+    }
+
+    void rebuild_index() {
+        index.clear();
+        size_t position = 0;
+        for (auto it = list.cbegin(); it != list.cend(); ++it, ++position) {
+            if (position % kStride == 0) {
+                index.push_back(Segment{it, 0});
+            }
+            ++index.back().count;
+        }
+    }
+
+    // Слишком длинный участок делится пополам
+    void split_segment(size_t segment) {
+        if (index[segment].count <= 2 * kStride) return;
+        ConstIterator middle = index[segment].first;
+        size_t half = index[segment].count / 2;
+        std::advance(middle, half);
+        index.insert(index.begin() + static_cast<std::ptrdiff_t>(segment) + 1,
+                     Segment{middle, index[segment].count - half});
+        index[segment].count = half;
+    }
+
+    // Короткие соседние участки сливаются
+    void merge_segments(size_t segment) {
+        if (segment + 1 < index.size() && index[segment].count + index[segment + 1].count <= kStride) {
+            index[segment].count += index[segment + 1].count;
+            index.erase(index.begin() + static_cast<std::ptrdiff_t>(segment) + 1);
+        }
+        if (segment > 0 && segment < index.size() &&
+            index[segment - 1].count + index[segment].count <= kStride) {
+            index[segment - 1].count += index[segment].count;
+            index.erase(index.begin() + static_cast<std::ptrdiff_t>(segment));
+        }
+    }
+
+    // Последний узел участка segment, для которого comp(*node, key) (strict)
+    // или !comp(key, *node) (не strict): после него стоит искомая позиция
+    template <typename Key>
+    ConstIterator walk_segment(size_t segment, const Key& key, bool strict) const {
+        ConstIterator prev = index[segment].first;
+        ConstIterator next = std::next(prev);
+        while (next != list.cend() && (strict ? comp(*next, key) : !comp(key, *next))) {
+            prev = next;
+            ++next;
+        }
+        return prev;
+    }
+
+public:
+    explicit SortedSingleLinkedList(std::pmr::memory_resource* resource = nullptr, Compare compare = Compare())
+        : list(resource ? resource : std::pmr::get_default_resource()),
+          index(list.get_allocator().resource()), comp(std::move(compare)) {}
+
+    // Элементы диапазона сортируются; индекс строится одним проходом
+    template <typename InputIt, typename = std::enable_if_t<std::is_convertible_v<
+                  typename std::iterator_traits<InputIt>::iterator_category, std::input_iterator_tag>>>
+    SortedSingleLinkedList(InputIt first, InputIt last, std::pmr::memory_resource* resource = nullptr,
+                           Compare compare = Compare())
+        : SortedSingleLinkedList(resource, std::move(compare)) {
+        assign(first, last);
+    }
+
+    SortedSingleLinkedList(const SortedSingleLinkedList& other)
+        : list(other.list), index(list.get_allocator().resource()), comp(other.comp) {
+        rebuild_index();
+    }
+
+    // Узлы переходят вместе с индексом
+    SortedSingleLinkedList(SortedSingleLinkedList&& other)
+        : list(std::move(other.list)), index(std::move(other.index)), comp(std::move(other.comp)) {
+        other.index.clear();
+    }
+
+    SortedSingleLinkedList& operator=(const SortedSingleLinkedList& other) {
+        if (this != &other) {
+            list = other.list;
+            comp = other.comp;
+            rebuild_index();
+        }
+        return *this;
+    }
+
+    // При разных аллокаторах элементы переносятся в новые узлы, и индекс строится заново
+    SortedSingleLinkedList& operator=(SortedSingleLinkedList&& other) {
+        if (this != &other) {
+            bool same_nodes = list.get_allocator() == other.list.get_allocator();
+            list = std::move(other.list);
+            comp = std::move(other.comp);
+            if (same_nodes) {
+                index = std::move(other.index);
+            } else {
+                rebuild_index();
+            }
+            other.index.clear();
+        }
+        return *this;
+    }
+
+    template <typename InputIt, typename = std::enable_if_t<std::is_convertible_v<
+                  typename std::iterator_traits<InputIt>::iterator_category, std::input_iterator_tag>>>
+    void assign(InputIt first, InputIt last) {
+        List sorted(first, last, list.get_allocator());
+        sorted.sort(comp);
+        index.clear();
+        list = std::move(sorted);
+        rebuild_index();
+    }
+
+    // Вставка с сохранением порядка: равные элементы идут в порядке вставки
+    template <typename... Args>
+    ConstIterator emplace(Args&&... args) {
+        T value(std::forward<Args>(args)...);
+        size_t segment = find_segment(value, true);
+        if (segment == 0) {
+            // Новый наименьший элемент становится началом первого участка
+            list.push_front(std::move(value));
+            if (index.empty()) {
+                index.push_back(Segment{list.cbegin(), 1});
+            } else {
+                index[0].first = list.cbegin();
+                ++index[0].count;
+                split_segment(0);
+            }
+            return list.cbegin();
+        }
+        --segment;
+        ConstIterator inserted = list.insert_after(walk_segment(segment, value, false), std::move(value));
+        ++index[segment].count;
+        split_segment(segment);
+        return inserted;
+    }
+
+    ConstIterator insert(const T& value) { return emplace(value); }
+    ConstIterator insert(T&& value) { return emplace(std::move(value)); }
+
+    // Первый элемент, не меньший key, или end()
+    template <typename Key = T>
+    ConstIterator lower_bound(const Key& key) const {
+        size_t segment = find_segment(key, false);
+        if (segment == 0) return list.cbegin();
+        return std::next(walk_segment(segment - 1, key, true));
+    }
+
+    template <typename Key = T>
+    ConstIterator find(const Key& key) const {
+        ConstIterator it = lower_bound(key);
+        return it != list.cend() && !comp(key, *it) ? it : list.cend();
+    }
+
+    template <typename Key = T>
+    bool contains(const Key& key) const {
+        return find(key) != list.cend();
+    }
+
+    // Удаляет первый элемент, равный key; false, если такого нет
+    template <typename Key = T>
+    bool erase(const Key& key) {
+        size_t segment = find_segment(key, false);
+        ConstIterator prev;
+        ConstIterator target = list.cbegin();
+        if (segment > 0) {
+            prev = walk_segment(segment - 1, key, true);
+            target = std::next(prev);
+        }
+        if (target == list.cend() || comp(key, *target)) return false;
+
+        // Удаляемый узел - начало участка segment или внутри предыдущего участка
+        bool starts_segment = segment < index.size() && index[segment].first == target;
+        size_t owner = starts_segment ? segment : segment - 1;
+        ConstIterator after = segment > 0 ? ConstIterator(list.erase_after(prev))
+                                          : (list.pop_front(), list.cbegin());
+        if (--index[owner].count == 0) {
+            index.erase(index.begin() + static_cast<std::ptrdiff_t>(owner));
+            return true;
+        }
+        if (starts_segment) index[owner].first = after;
+        merge_segments(owner);
+        return true;
+    }
+
+    // Удаляет все элементы, равные key; возвращает их число
+    template <typename Key = T>
+    size_t erase_all(const Key& key) {
+        size_t removed = 0;
+        while (erase(key)) ++removed;
+        return removed;
+    }
+
+    const T& front() const { return list.front(); }
+
+    void pop_front() {
+        list.pop_front();
+        if (--index[0].count == 0) {
+            index.erase(index.begin());
+            return;
+        }
+        index[0].first = list.cbegin();
+        merge_segments(0);
+    }
+
+    ConstIterator begin() const { return list.cbegin(); }
+    ConstIterator end() const { return list.cend(); }
+    ConstIterator cbegin() const { return list.cbegin(); }
+    ConstIterator cend() const { return list.cend(); }
+
+    bool empty() const { return list.empty(); }
+    size_t size() const { return list.size(); }
+
+    void clear() {
+        index.clear();
+        list.clear();
+    }
+
+    // Число участков индекса
+    size_t index_size() const noexcept { return index.size(); }
+
+    // Доступ к списку только на чтение
+    const List& base() const noexcept { return list; }
+
+    allocator_type get_allocator() const { return list.get_allocator(); }
+};
+
+#endif
@@ -0,0 +1,172 @@
+#ifndef LIST_TRACE_H
+#define LIST_TRACE_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <ostream>
+#include <cstddef>
+#include <cstdint>
+
+// Трассировка задержек узлов списка и memory_resource. По умолчанию выключена:
+// макросы SLL_TRACE_* раскрываются в пустые выражения и ничего не стоят. С
+// -DSLL_ENABLE_TRACING (опция CMake SLL_ENABLE_TRACING) точки трассировки
+// замеряют время в гистограммы по операциям, а при наличии <sys/sdt.h> ставят
+// маркеры USDT (провайдер sll) вокруг обращений к родительскому ресурсу -
+// их видят perf, bpftrace и SystemTap без пересборки.
+namespace list_trace {
+    // Замеряемые операции
+    enum class Event : size_t {
+        ListCreateNode,
+        ListDestroyNode,
+        ResourceAllocate,
+        ResourceDeallocate,
+        ParentAllocate,
+        ParentDeallocate,
+        Count
+    };
+
+    inline const char* event_name(Event event) noexcept {
+        static constexpr const char* names[] = {
+            "list_create_node", "list_destroy_node", "resource_allocate",
+            "resource_deallocate", "parent_allocate", "parent_deallocate"};
+        return event < Event::Count ? names[static_cast<size_t>(event)] : "unknown";
+    }
+
+    // Гистограмма задержек в наносекундах с корзинами по степеням двойки:
+    // корзина i хранит значения из [2^(i-1), 2^i). Запись - несколько relaxed-атомиков,
+    // безопасна из любого числа потоков.
+    class LatencyHistogram {
+    public:
+        static constexpr size_t kBuckets = 64;
+
+    private:
+        std::array<std::atomic<uint64_t>, kBuckets> buckets{};
+        std::atomic<uint64_t> samples{0};
+        std::atomic<uint64_t> total_ns{0};
+        std::atomic<uint64_t> max_ns{0};
+
+        static size_t bucket_index(uint64_t ns) noexcept {
+            size_t index = 0;
+            while (ns) {
+                ns >>= 1;
+                ++index;
+            }
+            return index < kBuckets ? index : kBuckets - 1;
+        }
+
+    public:
+        void record(uint64_t ns) noexcept {
+            buckets[bucket_index(ns)].fetch_add(1, std::memory_order_relaxed);
+            samples.fetch_add(1, std::memory_order_relaxed);
+            total_ns.fetch_add(ns, std::memory_order_relaxed);
+            uint64_t seen = max_ns.load(std::memory_order_relaxed);
+            while (ns > seen && !max_ns.compare_exchange_weak(seen, ns, std::memory_order_relaxed)) {
+            }
+        }
+
+        uint64_t count() const noexcept { return samples.load(std::memory_order_relaxed); }
+        uint64_t max() const noexcept { return max_ns.load(std::memory_order_relaxed); }
+
+        double mean() const noexcept {
+            uint64_t n = count();
+            return n ? static_cast<double>(total_ns.load(std::memory_order_relaxed)) / static_cast<double>(n) : 0.0;
+        }
+
+        uint64_t bucket_count(size_t index) const noexcept {
+            return index < kBuckets ? buckets[index].load(std::memory_order_relaxed) : 0;
+        }
+
+        // Верхняя граница корзины, в которую попадает доля q замеров (0 < q <= 1);
+        // не больше максимума. 0, если замеров нет.
+        uint64_t percentile(double q) const noexcept {
+            uint64_t n = count();
+            if (n == 0) return 0;
+            uint64_t rank = static_cast<uint64_t>(std::ceil(q * static_cast<double>(n)));
+            if (rank == 0) rank = 1;
+            uint64_t seen = 0;
+            for (size_t i = 0; i < kBuckets; ++i) {
+                seen += bucket_count(i);
+                if (seen >= rank) {
+                    uint64_t upper = i == 0 ? 0 : (uint64_t{1} << i) - 1;
+                    return upper < max() ? upper : max();
+                }
+            }
+            return max();
+        }
+
+        void reset() noexcept {
+            for (auto& bucket : buckets) bucket.store(0, std::memory_order_relaxed);
+            samples.store(0, std::memory_order_relaxed);
+            total_ns.store(0, std::memory_order_relaxed);
+            max_ns.store(0, std::memory_order_relaxed);
+        }
+    };
+
+    // Гистограмма операции; общая для всех списков и ресурсов процесса
+    inline LatencyHistogram& histogram(Event event) noexcept {
+        static std::array<LatencyHistogram, static_cast<size_t>(Event::Count)> histograms;
+        return histograms[static_cast<size_t>(event)];
+    }
+
+    inline void reset_all() noexcept {
+        for (size_t i = 0; i < static_cast<size_t>(Event::Count); ++i) {
+            histogram(static_cast<Event>(i)).reset();
+        }
+    }
+
+    // Таблица по операциям с замерами: число, среднее, p50, p99, p99.9, максимум (нс)
+    inline void report(std::ostream& os) {
+        os << "operation count mean_ns p50_ns p99_ns p999_ns max_ns\n";
+        for (size_t i = 0; i < static_cast<size_t>(Event::Count); ++i) {
+            Event event = static_cast<Event>(i);
+            const LatencyHistogram& h = histogram(event);
+            if (h.count() == 0) continue;
+            os << event_name(event) << ' ' << h.count() << ' ' << h.mean() << ' ' << h.percentile(0.5) << ' '
+               << h.percentile(0.99) << ' ' << h.percentile(0.999) << ' ' << h.max() << '\n';
+        }
+    }
+
+    // Замер времени жизни объекта в гистограмму
+    class ScopedTimer {
+        LatencyHistogram& target;
+        std::chrono::steady_clock::time_point start;
+
+    public:
+        explicit ScopedTimer(LatencyHistogram& h) noexcept
+            : target(h), start(std::chrono::steady_clock::now()) {}
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+        ~ScopedTimer() {
+            auto elapsed = std::chrono::steady_clock::now() - start;
+            target.record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+        }
+    };
+}
+
+#define SLL_TRACE_CONCAT_IMPL(a, b) a##b
+#define SLL_TRACE_CONCAT(a, b) SLL_TRACE_CONCAT_IMPL(a, b)
+
+#ifdef SLL_ENABLE_TRACING
+#define SLL_TRACE_SCOPE(event) \
+    ::list_trace::ScopedTimer SLL_TRACE_CONCAT(sll_trace_timer_, __LINE__)(::list_trace::histogram(event))
+#else
+#define SLL_TRACE_SCOPE(event) static_cast<void>(0)
+#endif
+
+// Маркер USDT sll:name с двумя числовыми аргументами
+#if defined(SLL_ENABLE_TRACING) && defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define SLL_TRACE_PROBE(name, a, b) DTRACE_PROBE2(sll, name, a, b)
+#endif
+#endif
+
+#ifndef SLL_TRACE_PROBE
+#define SLL_TRACE_PROBE(name, a, b) static_cast<void>(0)
+#endif
+
+#endif
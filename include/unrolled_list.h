@@ -0,0 +1,431 @@
+#ifndef UNROLLED_SINGLE_LINKED_LIST_H
+#define UNROLLED_SINGLE_LINKED_LIST_H
+
+#include <iterator>
+#include <stdexcept>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <memory_resource>
+#include <algorithm>
+#include <utility>
+#include <cstddef>
+
+// Число элементов в узле по умолчанию: узел целиком занимает около 128 байт
+template <typename T>
+constexpr size_t unrolled_default_capacity() {
+    constexpr size_t header = 2 * sizeof(void*);
+    return sizeof(T) + header >= 128 ? 1 : (128 - header) / sizeof(T);
+}
+
+// Односвязный список, хранящий до N элементов в каждом узле.
+// Обход идёт по плотным массивам, поэтому промах кэша приходится на узел, а не на элемент.
+// Вставка и удаление сдвигают не больше N элементов внутри узла; полный узел делится пополам.
+// В отличие от SingleLinkedList, вставка и удаление делают недействительными
+// итераторы на элементы того же узла, стоящие после позиции.
+template <typename T, size_t N = unrolled_default_capacity<T>()>
+class UnrolledSingleLinkedList {
+    static_assert(N > 0, "Node capacity must be positive");
+
+private:
+    struct Node {
+        Node* next = nullptr;
+        size_t count = 0;
+        alignas(T) unsigned char storage[N * sizeof(T)];
+
+        T* data() noexcept { return std::launder(reinterpret_cast<T*>(storage)); }
+        const T* data() const noexcept { return std::launder(reinterpret_cast<const T*>(storage)); }
+        T* slot(size_t index) noexcept { return reinterpret_cast<T*>(storage) + index; }
+    };
+
+    using NodeAllocator = std::pmr::polymorphic_allocator<Node>;
+
+    Node* head = nullptr;
+    size_t list_size = 0;
+    NodeAllocator alloc;
+
+    Node* create_node(Node* next) {
+        Node* node = alloc.allocate(1);
+        ::new (static_cast<void*>(node)) Node;
+        node->next = next;
+        return node;
+    }
+
+    void destroy_node(Node* node) {
+        std::destroy(node->data(), node->data() + node->count);
+        node->~Node();
+        alloc.deallocate(node, 1);
+    }
+
+    void destroy_all() {
+        while (head) {
+            Node* next = head->next;
+            destroy_node(head);
+            head = next;
+        }
+        list_size = 0;
+    }
+
+    // Конструирование элемента в позиции index узла со сдвигом хвоста узла вправо; в узле есть место
+    template <typename... Args>
+    static void insert_in_node(Node* node, size_t index, Args&&... args) {
+        if (index == node->count) {
+            ::new (static_cast<void*>(node->slot(index))) T(std::forward<Args>(args)...);
+            ++node->count;
+            return;
+        }
+        T value(std::forward<Args>(args)...);
+        T* data = node->data();
+        ::new (static_cast<void*>(node->slot(node->count))) T(std::move(data[node->count - 1]));
+        ++node->count;
+        std::move_backward(data + index, data + node->count - 2, data + node->count - 1);
+        data[index] = std::move(value);
+    }
+
+    // Удаление элемента index со сдвигом хвоста узла влево
+    static void erase_in_node(Node* node, size_t index) {
+        T* data = node->data();
+        std::move(data + index + 1, data + node->count, data + index);
+        --node->count;
+        data[node->count].~T();
+    }
+
+    // Перенос верхней половины полного узла в новый узел после него
+    Node* split(Node* node) {
+        Node* upper = create_node(node->next);
+        size_t keep = N / 2;
+        T* data = node->data();
+        try {
+            for (size_t i = keep; i < node->count; ++i) {
+                ::new (static_cast<void*>(upper->slot(upper->count))) T(std::move(data[i]));
+                ++upper->count;
+            }
+        } catch (...) {
+            destroy_node(upper);
+            throw;
+        }
+        std::destroy(data + keep, data + node->count);
+        node->count = keep;
+        node->next = upper;
+        return upper;
+    }
+
+    // Дописывание элемента в конец цепочки, которую строит копирование
+    template <typename U>
+    void append(Node*& tail, U&& value) {
+        if (!tail || tail->count == N) {
+            Node* node = create_node(nullptr);
+            (tail ? tail->next : head) = node;
+            tail = node;
+        }
+        insert_in_node(tail, tail->count, std::forward<U>(value));
+        ++list_size;
+    }
+
+    template <typename InputIt>
+    void append_range(InputIt first, InputIt last) {
+        Node* tail = nullptr;
+        try {
+            for (; first != last; ++first) {
+                append(tail, *first);
+            }
+        } catch (...) {
+            destroy_all();
+            throw;
+        }
+    }
+
+public:
+    using value_type = T;
+    using allocator_type = std::pmr::polymorphic_allocator<T>;
+    using size_type = size_t;
+
+    static constexpr size_t node_capacity = N;
+
+    // Итератор: узел и индекс элемента в нём
+    class Iterator {
+        friend class UnrolledSingleLinkedList;
+        Node* node;
+        size_t index;
+
+    public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = T;
+        using reference = T&;
+        using pointer = T*;
+        using iterator_category = std::forward_iterator_tag;
+
+        Iterator(Node* n = nullptr, size_t i = 0) : node(n), index(i) {}
+
+        reference operator*() const { return node->data()[index]; }
+        pointer operator->() const { return node->data() + index; }
+
+        Iterator& operator++() {
+            if (node && ++index == node->count) {
+                node = node->next;
+                index = 0;
+            }
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        bool operator==(const Iterator& other) const { return node == other.node && index == other.index; }
+        bool operator!=(const Iterator& other) const { return !(*this == other); }
+    };
+
+    // Константный итератор
+    class ConstIterator {
+        friend class UnrolledSingleLinkedList;
+        const Node* node;
+        size_t index;
+
+    public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = T;
+        using reference = const T&;
+        using pointer = const T*;
+        using iterator_category = std::forward_iterator_tag;
+
+        ConstIterator(const Node* n = nullptr, size_t i = 0) : node(n), index(i) {}
+        ConstIterator(const Iterator& it) : node(it.node), index(it.index) {}
+
+        reference operator*() const { return node->data()[index]; }
+        pointer operator->() const { return node->data() + index; }
+
+        ConstIterator& operator++() {
+            if (node && ++index == node->count) {
+                node = node->next;
+                index = 0;
+            }
+            return *this;
+        }
+
+        ConstIterator operator++(int) {
+            ConstIterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        bool operator==(const ConstIterator& other) const { return node == other.node && index == other.index; }
+        bool operator!=(const ConstIterator& other) const { return !(*this == other); }
+    };
+
+    // Конструкторы
+    UnrolledSingleLinkedList() : alloc(std::pmr::get_default_resource()) {}
+
+    explicit UnrolledSingleLinkedList(std::pmr::memory_resource* resource)
+        : alloc(resource) {}
+
+    explicit UnrolledSingleLinkedList(const std::pmr::polymorphic_allocator<T>& allocator)
+        : alloc(allocator) {}
+
+    // Конструктор из диапазона: узлы заполняются целиком, элементы в исходном порядке
+    template <typename InputIt, typename = std::enable_if_t<std::is_convertible_v<
+                  typename std::iterator_traits<InputIt>::iterator_category, std::input_iterator_tag>>>
+    UnrolledSingleLinkedList(InputIt first, InputIt last, const allocator_type& allocator = allocator_type())
+        : alloc(allocator) {
+        append_range(first, last);
+    }
+
+    // Копия плотно упакована независимо от заполненности узлов оригинала
+    UnrolledSingleLinkedList(const UnrolledSingleLinkedList& other)
+        : alloc(other.alloc) {
+        append_range(other.begin(), other.end());
+    }
+
+    UnrolledSingleLinkedList(UnrolledSingleLinkedList&& other) noexcept
+        : head(other.head), list_size(other.list_size), alloc(other.alloc) {
+        other.head = nullptr;
+        other.list_size = 0;
+    }
+
+    UnrolledSingleLinkedList& operator=(const UnrolledSingleLinkedList& other) {
+        if (this != &other) {
+            UnrolledSingleLinkedList temp(other.begin(), other.end(), alloc);
+            swap(temp);
+        }
+        return *this;
+    }
+
+    UnrolledSingleLinkedList& operator=(UnrolledSingleLinkedList&& other) {
+        if (this != &other) {
+            if (alloc == other.alloc) {
+                destroy_all();
+                head = other.head;
+                list_size = other.list_size;
+                other.head = nullptr;
+                other.list_size = 0;
+            } else {
+                UnrolledSingleLinkedList temp(std::make_move_iterator(other.begin()),
+                                              std::make_move_iterator(other.end()), alloc);
+                swap(temp);
+                other.clear();
+            }
+        }
+        return *this;
+    }
+
+    ~UnrolledSingleLinkedList() {
+        destroy_all();
+    }
+
+    // Обмен содержимым; аллокаторы должны совпадать
+    void swap(UnrolledSingleLinkedList& other) noexcept {
+        using std::swap;
+        swap(head, other.head);
+        swap(list_size, other.list_size);
+    }
+
+    // Доступ к элементам
+    T& front() {
+        if (!head) throw std::logic_error("List is empty");
+        return head->data()[0];
+    }
+
+    const T& front() const {
+        if (!head) throw std::logic_error("List is empty");
+        return head->data()[0];
+    }
+
+    // Модификаторы
+    void push_front(const T& value) {
+        emplace_front(value);
+    }
+
+    void push_front(T&& value) {
+        emplace_front(std::move(value));
+    }
+
+    template <typename... Args>
+    T& emplace_front(Args&&... args) {
+        if (!head || head->count == N) {
+            Node* node = create_node(head);
+            try {
+                insert_in_node(node, 0, std::forward<Args>(args)...);
+            } catch (...) {
+                destroy_node(node);
+                throw;
+            }
+            head = node;
+        } else {
+            insert_in_node(head, 0, std::forward<Args>(args)...);
+        }
+        ++list_size;
+        return head->data()[0];
+    }
+
+    void pop_front() {
+        if (!head) throw std::logic_error("List is empty");
+        erase_in_node(head, 0);
+        if (head->count == 0) {
+            Node* next = head->next;
+            destroy_node(head);
+            head = next;
+        }
+        --list_size;
+    }
+
+    // Итераторы
+    Iterator before_begin() { return Iterator(nullptr); }
+    ConstIterator before_begin() const { return ConstIterator(nullptr); }
+
+    Iterator begin() { return Iterator(head); }
+    ConstIterator begin() const { return ConstIterator(head); }
+    ConstIterator cbegin() const { return ConstIterator(head); }
+
+    Iterator end() { return Iterator(nullptr); }
+    ConstIterator end() const { return ConstIterator(nullptr); }
+    ConstIterator cend() const { return ConstIterator(nullptr); }
+
+    // Вставка после позиции
+    Iterator insert_after(ConstIterator pos, const T& value) {
+        return emplace_after(pos, value);
+    }
+
+    Iterator insert_after(ConstIterator pos, T&& value) {
+        return emplace_after(pos, std::move(value));
+    }
+
+    template <typename... Args>
+    Iterator emplace_after(ConstIterator pos, Args&&... args) {
+        if (pos.node == nullptr) {
+            // before_begin(): вставка в начало
+            emplace_front(std::forward<Args>(args)...);
+            return Iterator(head);
+        }
+        Node* node = const_cast<Node*>(pos.node);
+        size_t index = pos.index + 1;
+        if (node->count == N) {
+            if (index == N) {
+                // Дописывание за последним элементом полного узла - в новый узел, без деления
+                Node* next = create_node(node->next);
+                try {
+                    insert_in_node(next, 0, std::forward<Args>(args)...);
+                } catch (...) {
+                    destroy_node(next);
+                    throw;
+                }
+                node->next = next;
+                ++list_size;
+                return Iterator(next, 0);
+            }
+            Node* upper = split(node);
+            if (index > node->count) {
+                index -= node->count;
+                node = upper;
+            }
+        }
+        insert_in_node(node, index, std::forward<Args>(args)...);
+        ++list_size;
+        return Iterator(node, index);
+    }
+
+    // Удаление после позиции
+    Iterator erase_after(ConstIterator pos) {
+        if (pos.node == nullptr) {
+            if (!head) throw std::logic_error("Invalid iterator for erase_after");
+            pop_front();
+            return Iterator(head);
+        }
+        Node* node = const_cast<Node*>(pos.node);
+        if (pos.index + 1 < node->count) {
+            erase_in_node(node, pos.index + 1);
+            --list_size;
+            if (pos.index + 1 < node->count) return Iterator(node, pos.index + 1);
+            return Iterator(node->next);
+        }
+        Node* next = node->next;
+        if (!next) throw std::logic_error("Invalid iterator for erase_after");
+        erase_in_node(next, 0);
+        --list_size;
+        if (next->count == 0) {
+            node->next = next->next;
+            destroy_node(next);
+            return Iterator(node->next);
+        }
+        return Iterator(next);
+    }
+
+    // Наблюдатели
+    bool empty() const { return list_size == 0; }
+    size_t size() const { return list_size; }
+
+    void clear() {
+        destroy_all();
+    }
+
+    // Аллокатор
+    allocator_type get_allocator() const { return alloc; }
+};
+
+template <typename T, size_t N>
+void swap(UnrolledSingleLinkedList<T, N>& lhs, UnrolledSingleLinkedList<T, N>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+#endif
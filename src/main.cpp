@@ -1,5 +1,6 @@
 #include <iostream>
 #include <string>
+#include <sstream>
 #include "../include/allocator.h"
 #include "../include/list.h"
 
@@ -17,6 +18,22 @@ struct Person {
     }
 };
 
+// Двоичный формат Person для SingleLinkedList::save/load
+template <>
+struct BinarySerializer<Person> {
+    static void write(std::ostream& os, const Person& p) {
+        binary_io::write_value(os, p.id);
+        binary_io::write_value(os, p.age);
+        BinarySerializer<std::string>::write(os, p.name);
+    }
+
+    static Person read(std::istream& is) {
+        int id = binary_io::read_value<int>(is);
+        int age = binary_io::read_value<int>(is);
+        return Person(id, BinarySerializer<std::string>::read(is), age);
+    }
+};
+
 void demo_simple_types() {
     std::cout << "=== DEMONSTRATION WITH SIMPLE TYPES (int) ===\n";
     
@@ -86,6 +103,26 @@ void demo_iterator_operations() {
     }
 }
 
+void demo_serialization() {
+    std::cout << "\n=== DEMONSTRATION OF BINARY SAVE/LOAD ===\n";
+
+    auto custom_resource = std::make_unique<CustomMemoryResource>();
+    SingleLinkedList<Person> person_list(custom_resource.get());
+    person_list.push_front(Person(1, "Alice", 25));
+    person_list.push_front(Person(2, "Bob", 30));
+
+    std::stringstream storage;
+    person_list.save(storage);
+    std::cout << "Saved " << person_list.size() << " persons into " << storage.str().size() << " bytes\n";
+
+    SingleLinkedList<Person> restored(custom_resource.get());
+    restored.load(storage);
+    std::cout << "Restored list:\n";
+    for (const auto& person : restored) {
+        std::cout << "  " << person << "\n";
+    }
+}
+
 int main() {
     std::cout << "=== SINGLE LINKED LIST WITH CUSTOM MEMORY RESOURCE DEMO ===\n\n";
     
@@ -93,6 +130,12 @@ int main() {
         demo_simple_types();
         demo_complex_types();
         demo_iterator_operations();
+        demo_serialization();
+
+#ifdef SLL_ENABLE_TRACING
+        std::cout << "\n=== NODE AND ALLOCATOR LATENCY ===\n";
+        list_trace::report(std::cout);
+#endif
         
         std::cout << "\n=== ALL DEMONSTRATIONS COMPLETED SUCCESSFULLY ===\n";
         
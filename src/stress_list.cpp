@@ -0,0 +1,496 @@
+// Нагрузочный драйвер SingleLinkedList: смешанные push_front/pop_front/insert_after/erase_after
+// на списках заданного размера в нескольких потоках, с разными memory_resource.
+// Печатает пропускную способность, RSS и статистику аллокатора в CSV или JSON.
+//
+//   stress_list --resource all --type string --size 1000000 --ops 10000000 --threads 4
+//   stress_list --mix 50:50:0:0 --format json
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../include/allocator.h"
+#include "../include/concurrent_allocator.h"
+#include "../include/list.h"
+
+#if __has_include(<sys/resource.h>) && __has_include(<unistd.h>)
+#include <sys/resource.h>
+#include <unistd.h>
+#define STRESS_HAS_RUSAGE 1
+#endif
+
+namespace {
+
+struct Options {
+    size_t ops = 1000000;       // операций на поток
+    size_t size = 100000;       // начальный размер списка каждого потока
+    size_t threads = 1;
+    size_t repeat = 1;
+    unsigned weights[4] = {40, 30, 20, 10}; // push_front:pop_front:insert_after:erase_after
+    std::string type = "int";
+    std::vector<std::string> resources{"custom"};
+    std::string format = "csv";
+    uint64_t seed = 42;
+};
+
+const char* const kResourceNames[] = {"newdelete", "pool", "custom", "custom-slab", "fast", "concurrent"};
+const char* const kTypeNames[] = {"int", "string"};
+
+// Статистика аллокатора; поля, которые ресурс не считает, в отчёт не попадают.
+// Счётчики складываются, а peak_bytes_from_parent - максимум по ресурсам: пики
+// разных потоков приходятся на разное время, и их сумма пиком не является.
+struct AllocatorStats {
+    bool block_counts = false;   // allocations, deallocations, reuse_hits
+    bool parent_counts = false;  // parent_fallbacks, peak_bytes_from_parent
+    size_t allocations = 0;
+    size_t deallocations = 0;
+    size_t reuse_hits = 0;
+    size_t parent_fallbacks = 0;
+    size_t peak_bytes_from_parent = 0;
+
+    template <typename Stats>
+    void add(const Stats& s, bool with_blocks, bool with_parent = true) {
+        if (with_blocks) {
+            block_counts = true;
+            allocations += s.allocations;
+            deallocations += s.deallocations;
+            reuse_hits += s.reuse_hits;
+        }
+        if (with_parent) {
+            parent_counts = true;
+            parent_fallbacks += s.parent_fallbacks;
+            peak_bytes_from_parent = std::max(peak_bytes_from_parent, s.peak_bytes_from_parent);
+        }
+    }
+
+    void add(const AllocatorStats& s) {
+        add(s, s.block_counts, s.parent_counts);
+    }
+};
+
+// Результат одного прогона
+struct Result {
+    std::string resource;
+    std::string type;
+    size_t threads = 0;
+    size_t size = 0;
+    size_t ops = 0;
+    size_t counts[4] = {};      // выполнено операций каждого вида
+    double seconds = 0;
+    double destroy_seconds = 0;
+    size_t final_size = 0;
+    size_t rss_kb = 0;
+    size_t peak_rss_kb = 0;
+    AllocatorStats stats;
+};
+
+void print_usage(std::ostream& os) {
+    os << "usage: stress_list [options]\n"
+          "  --ops N          operations per thread (default 1000000)\n"
+          "  --size N         initial list size per thread (default 100000)\n"
+          "  --threads N      worker threads, one list each (default 1)\n"
+          "  --mix P:O:I:E    weights of push_front:pop_front:insert_after:erase_after (default 40:30:20:10)\n"
+          "  --type T         int | string (default int)\n"
+          "  --resource R     newdelete | pool | custom | custom-slab | fast | concurrent | all,\n"
+          "                   comma separated (default custom)\n"
+          "  --repeat N       runs per configuration (default 1)\n"
+          "  --format F       csv | json (default csv)\n"
+          "  --seed N         random seed (default 42)\n";
+}
+
+size_t parse_count(const std::string& value, const char* option) {
+    // Экспоненциальная запись допускается, чтобы писать 1e8
+    size_t used = 0;
+    double parsed = 0;
+    try {
+        parsed = std::stod(value, &used);
+    } catch (const std::exception&) {
+        used = 0;
+    }
+    if (used != value.size() || parsed < 0 || parsed > 1e15) {
+        throw std::invalid_argument(std::string("Invalid value for ") + option + ": " + value);
+    }
+    return static_cast<size_t>(parsed);
+}
+
+std::vector<std::string> split(const std::string& value, char separator) {
+    std::vector<std::string> parts;
+    size_t start = 0;
+    for (;;) {
+        size_t end = value.find(separator, start);
+        parts.push_back(value.substr(start, end - start));
+        if (end == std::string::npos) return parts;
+        start = end + 1;
+    }
+}
+
+template <size_t N>
+bool known(const char* const (&names)[N], const std::string& value) {
+    return std::find(std::begin(names), std::end(names), value) != std::end(names);
+}
+
+Options parse_options(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string option = argv[i];
+        if (option == "--help" || option == "-h") {
+            print_usage(std::cout);
+            std::exit(0);
+        }
+        if (i + 1 >= argc) throw std::invalid_argument("Missing value for " + option);
+        std::string value = argv[++i];
+
+        if (option == "--ops") {
+            options.ops = parse_count(value, "--ops");
+        } else if (option == "--size") {
+            options.size = parse_count(value, "--size");
+        } else if (option == "--threads") {
+            options.threads = parse_count(value, "--threads");
+            if (options.threads == 0) throw std::invalid_argument("--threads must be positive");
+        } else if (option == "--repeat") {
+            options.repeat = parse_count(value, "--repeat");
+        } else if (option == "--seed") {
+            options.seed = parse_count(value, "--seed");
+        } else if (option == "--mix") {
+            std::vector<std::string> parts = split(value, ':');
+            if (parts.size() != 4) throw std::invalid_argument("--mix expects four weights P:O:I:E");
+            unsigned total = 0;
+            for (size_t k = 0; k < 4; ++k) {
+                options.weights[k] = static_cast<unsigned>(parse_count(parts[k], "--mix"));
+                total += options.weights[k];
+            }
+            if (total == 0) throw std::invalid_argument("--mix weights must not all be zero");
+        } else if (option == "--type") {
+            if (!known(kTypeNames, value)) throw std::invalid_argument("Unknown element type: " + value);
+            options.type = value;
+        } else if (option == "--resource") {
+            options.resources.clear();
+            for (const std::string& name : split(value, ',')) {
+                if (name == "all") {
+                    options.resources.insert(options.resources.end(), std::begin(kResourceNames), std::end(kResourceNames));
+                } else if (known(kResourceNames, name)) {
+                    options.resources.push_back(name);
+                } else {
+                    throw std::invalid_argument("Unknown resource: " + name);
+                }
+            }
+        } else if (option == "--format") {
+            if (value != "csv" && value != "json") throw std::invalid_argument("Unknown format: " + value);
+            options.format = value;
+        } else {
+            throw std::invalid_argument("Unknown option: " + option);
+        }
+    }
+    return options;
+}
+
+// Текущий и пиковый RSS процесса в КиБ; 0, если платформа их не сообщает
+size_t current_rss_kb() {
+#ifdef STRESS_HAS_RUSAGE
+    std::ifstream statm("/proc/self/statm");
+    size_t total_pages = 0;
+    size_t resident_pages = 0;
+    if (statm >> total_pages >> resident_pages) {
+        return resident_pages * static_cast<size_t>(sysconf(_SC_PAGESIZE)) / 1024;
+    }
+#endif
+    return 0;
+}
+
+size_t peak_rss_kb() {
+#ifdef STRESS_HAS_RUSAGE
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) == 0) return static_cast<size_t>(usage.ru_maxrss);
+#endif
+    return 0;
+}
+
+// xorshift64*: дешевле std::mt19937_64 и не искажает замер операций списка
+class FastRandom {
+    uint64_t state;
+
+public:
+    explicit FastRandom(uint64_t seed) : state(seed ? seed : 0x9E3779B97F4A7C15ull) {}
+
+    uint64_t next() noexcept {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return state * 0x2545F4914F6CDD1Dull;
+    }
+};
+
+template <typename T>
+T make_value(uint64_t n);
+
+template <>
+int make_value<int>(uint64_t n) { return static_cast<int>(n); }
+
+// Строка длиннее буфера малой строки, чтобы каждый элемент владел своей памятью
+template <>
+std::string make_value<std::string>(uint64_t n) {
+    return "stress element #" + std::to_string(n) + " with heap storage";
+}
+
+// Смешанная нагрузка на список одного потока. Курсор проходит список от начала к концу:
+// insert_after и erase_after выполняются в позиции курсора, после чего курсор сдвигается.
+template <typename T>
+void run_workload(SingleLinkedList<T>& list, const Options& options, uint64_t seed, size_t (&counts)[4]) {
+    FastRandom random(seed);
+    unsigned limits[4];
+    unsigned total = 0;
+    for (size_t k = 0; k < 4; ++k) {
+        total += options.weights[k];
+        limits[k] = total;
+    }
+
+    auto cursor = list.before_begin();
+    for (size_t i = 0; i < options.ops; ++i) {
+        uint64_t r = random.next();
+        unsigned pick = static_cast<unsigned>(r % total);
+        size_t op = 0;
+        while (pick >= limits[op]) ++op;
+        if (list.empty() && (op == 1 || op == 3)) op = 0;
+
+        switch (op) {
+        case 0:
+            list.push_front(make_value<T>(r));
+            break;
+        case 1:
+            if (cursor == list.begin()) cursor = list.before_begin();
+            list.pop_front();
+            break;
+        case 2:
+            cursor = list.insert_after(cursor, make_value<T>(r));
+            break;
+        default:
+            // before_begin() совпадает с end(), поэтому удаление первого элемента - pop_front
+            if (cursor != list.before_begin() && std::next(cursor) == list.end()) cursor = list.before_begin();
+            if (cursor == list.before_begin()) {
+                list.pop_front();
+            } else {
+                list.erase_after(cursor);
+            }
+            break;
+        }
+        ++counts[op];
+
+        if (op >= 2 && ++cursor == list.end()) cursor = list.before_begin();
+    }
+}
+
+// Ресурс одного потока; "concurrent" - один общий ConcurrentMemoryResource на все потоки
+struct ResourceHolder {
+    std::unique_ptr<std::pmr::memory_resource> owned;
+    std::pmr::memory_resource* resource = nullptr;
+    CustomMemoryResource* custom = nullptr;
+    FastMemoryResource* fast = nullptr;
+
+    ResourceHolder(const std::string& name, std::pmr::memory_resource* shared) {
+        if (name == "newdelete") {
+            resource = std::pmr::new_delete_resource();
+        } else if (name == "pool") {
+            owned = std::make_unique<std::pmr::unsynchronized_pool_resource>();
+        } else if (name == "custom") {
+            auto r = std::make_unique<CustomMemoryResource>();
+            custom = r.get();
+            owned = std::move(r);
+        } else if (name == "custom-slab") {
+            auto r = std::make_unique<CustomMemoryResource>(nullptr, CustomMemoryResource::kDefaultSlabSize);
+            custom = r.get();
+            owned = std::move(r);
+        } else if (name == "fast") {
+            auto r = std::make_unique<FastMemoryResource>();
+            fast = r.get();
+            owned = std::move(r);
+        } else {
+            resource = shared;
+        }
+        if (owned) resource = owned.get();
+    }
+
+    // Статистика собственного ресурса потока. FastPolicy не считает маленькие блоки,
+    // поэтому от него берутся только обращения к родителю
+    void collect(AllocatorStats& total) const {
+        if (custom) {
+            total.add(custom->stats(), true);
+        } else if (fast) {
+            total.add(fast->stats(), false);
+        }
+    }
+};
+
+template <typename T>
+Result run_once(const Options& options, const std::string& resource_name, size_t repeat_index) {
+    Result result;
+    result.resource = resource_name;
+    result.type = options.type;
+    result.threads = options.threads;
+    result.size = options.size;
+    result.ops = options.ops * options.threads;
+
+    std::unique_ptr<ConcurrentMemoryResource> shared;
+    if (resource_name == "concurrent") shared = std::make_unique<ConcurrentMemoryResource>();
+
+    // Потоки заполняют списки, ждут общего старта, выполняют нагрузку и ждут замера разрушения
+    std::atomic<size_t> ready{0};
+    std::atomic<bool> start{false};
+    std::atomic<size_t> finished{0};
+    std::atomic<bool> destroy{false};
+    std::vector<size_t> final_sizes(options.threads);
+    std::vector<std::array<size_t, 4>> counts(options.threads);
+    std::vector<AllocatorStats> stats(options.threads);
+    std::vector<std::thread> workers;
+
+    for (size_t t = 0; t < options.threads; ++t) {
+        workers.emplace_back([&, t] {
+            ResourceHolder holder(resource_name, shared.get());
+            {
+                SingleLinkedList<T> list(holder.resource);
+                for (size_t i = 0; i < options.size; ++i) list.push_front(make_value<T>(i));
+                ready.fetch_add(1);
+                while (!start.load()) std::this_thread::yield();
+
+                size_t local[4] = {};
+                run_workload(list, options, options.seed + 1000003 * t + repeat_index, local);
+                std::copy(std::begin(local), std::end(local), counts[t].begin());
+                final_sizes[t] = list.size();
+                finished.fetch_add(1);
+                while (!destroy.load()) std::this_thread::yield();
+            }
+            holder.collect(stats[t]);
+            finished.fetch_add(1);
+        });
+    }
+
+    while (ready.load() < options.threads) std::this_thread::yield();
+    auto begin = std::chrono::steady_clock::now();
+    start.store(true);
+    while (finished.load() < options.threads) std::this_thread::yield();
+    auto end = std::chrono::steady_clock::now();
+    result.rss_kb = current_rss_kb();
+
+    destroy.store(true);
+    while (finished.load() < 2 * options.threads) std::this_thread::yield();
+    auto destroyed = std::chrono::steady_clock::now();
+    for (auto& worker : workers) worker.join();
+
+    result.seconds = std::chrono::duration<double>(end - begin).count();
+    result.destroy_seconds = std::chrono::duration<double>(destroyed - end).count();
+    result.peak_rss_kb = peak_rss_kb();
+    for (size_t t = 0; t < options.threads; ++t) {
+        for (size_t k = 0; k < 4; ++k) result.counts[k] += counts[t][k];
+        result.final_size += final_sizes[t];
+        result.stats.add(stats[t]);
+    }
+    // Общий пул: блоки, лежащие в кэшах потоков, в нём числятся выданными
+    if (shared) result.stats.add(shared->pool_stats(), true);
+    return result;
+}
+
+double mops(const Result& r) {
+    return r.seconds > 0 ? static_cast<double>(r.ops) / r.seconds / 1e6 : 0.0;
+}
+
+void print_csv_header(std::ostream& os) {
+    os << "resource,type,threads,size,ops,push_front,pop_front,insert_after,erase_after,seconds,mops,"
+          "destroy_seconds,final_size,rss_kb,peak_rss_kb,allocations,deallocations,reuse_hits,"
+          "parent_fallbacks,peak_bytes_from_parent\n";
+}
+
+void print_csv(std::ostream& os, const Result& r) {
+    os << r.resource << ',' << r.type << ',' << r.threads << ',' << r.size << ',' << r.ops;
+    for (size_t count : r.counts) os << ',' << count;
+    os << ',' << r.seconds << ',' << mops(r) << ',' << r.destroy_seconds << ',' << r.final_size << ','
+       << r.rss_kb << ',' << r.peak_rss_kb;
+    if (r.stats.block_counts) {
+        os << ',' << r.stats.allocations << ',' << r.stats.deallocations << ',' << r.stats.reuse_hits;
+    } else {
+        os << ",,,";
+    }
+    if (r.stats.parent_counts) {
+        os << ',' << r.stats.parent_fallbacks << ',' << r.stats.peak_bytes_from_parent;
+    } else {
+        os << ",,";
+    }
+    os << '\n';
+}
+
+void print_json(std::ostream& os, const Result& r, bool last) {
+    const char* names[] = {"push_front", "pop_front", "insert_after", "erase_after"};
+    os << "  {\"resource\": \"" << r.resource << "\", \"type\": \"" << r.type << "\", \"threads\": " << r.threads
+       << ", \"size\": " << r.size << ", \"ops\": " << r.ops << ", \"counts\": {";
+    for (size_t k = 0; k < 4; ++k) {
+        os << (k ? ", " : "") << '"' << names[k] << "\": " << r.counts[k];
+    }
+    os << "}, \"seconds\": " << r.seconds << ", \"mops\": " << mops(r) << ", \"destroy_seconds\": "
+       << r.destroy_seconds << ", \"final_size\": " << r.final_size << ", \"rss_kb\": " << r.rss_kb
+       << ", \"peak_rss_kb\": " << r.peak_rss_kb << ", \"allocator\": ";
+    if (r.stats.block_counts || r.stats.parent_counts) {
+        auto field = [&](const char* name, bool known, size_t value, bool first) {
+            os << (first ? "{\"" : ", \"") << name << "\": ";
+            if (known) {
+                os << value;
+            } else {
+                os << "null";
+            }
+        };
+        field("allocations", r.stats.block_counts, r.stats.allocations, true);
+        field("deallocations", r.stats.block_counts, r.stats.deallocations, false);
+        field("reuse_hits", r.stats.block_counts, r.stats.reuse_hits, false);
+        field("parent_fallbacks", r.stats.parent_counts, r.stats.parent_fallbacks, false);
+        field("peak_bytes_from_parent", r.stats.parent_counts, r.stats.peak_bytes_from_parent, false);
+        os << '}';
+    } else {
+        os << "null";
+    }
+    os << '}' << (last ? "\n" : ",\n");
+}
+
+}
+
+int main(int argc, char** argv) {
+    try {
+        Options options = parse_options(argc, argv);
+        size_t runs = options.resources.size() * options.repeat;
+        size_t done = 0;
+
+        if (options.format == "csv") {
+            print_csv_header(std::cout);
+        } else {
+            std::cout << "[\n";
+        }
+        for (const std::string& resource : options.resources) {
+            for (size_t repeat = 0; repeat < options.repeat; ++repeat) {
+                Result result = options.type == "int" ? run_once<int>(options, resource, repeat)
+                                                      : run_once<std::string>(options, resource, repeat);
+                ++done;
+                if (options.format == "csv") {
+                    print_csv(std::cout, result);
+                } else {
+                    print_json(std::cout, result, done == runs);
+                }
+                std::cout.flush();
+            }
+        }
+        if (options.format == "json") std::cout << "]\n";
+    } catch (const std::invalid_argument& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        print_usage(std::cerr);
+        return 1;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -1,7 +1,29 @@
 #include <gtest/gtest.h>
 #include <memory_resource>
+#include <thread>
+#include <sstream>
+#include <iterator>
+#include <list>
+#include <random>
+#include <numeric>
+#include <set>
+#include <forward_list>
+#include <unordered_map>
+#include <filesystem>
+#include <fstream>
 #include "../include/list.h"
 #include "../include/allocator.h"
+#include "../include/concurrent_allocator.h"
+#include "../include/concurrent_list.h"
+#include "../include/unrolled_list.h"
+#include "../include/parallel_list.h"
+#include "../include/small_list.h"
+#include "../include/persistent_list.h"
+#include "../include/sorted_list.h"
+#include "../include/hash_map.h"
+#include "../include/compact_list.h"
+#include "../include/rcu_list.h"
+#include "../include/trace.h"
 
 class SingleLinkedListTest : public ::testing::Test {
 protected:
@@ -319,8 +341,9 @@ TEST_F(SingleLinkedListTest, AllocatorUnknownPointer) {
     int dummy;
     void* unknown_ptr = &dummy;
     
-    // Не должно бросать исключение, только предупреждение в консоль
+    // Не должно бросать исключение, только регистрация аномалии
     EXPECT_NO_THROW(allocator.deallocate(unknown_ptr, 100, 8));
+    EXPECT_EQ(allocator.anomaly_count(AllocationAnomaly::UnknownPointer), 1u);
 }
 
 TEST_F(SingleLinkedListTest, AllocatorWithListIntegration) {
@@ -379,3 +402,2282 @@ TEST_F(SingleLinkedListTest, AllocatorMemoryReuseAfterClear) {
     EXPECT_EQ(result, std::vector<int>({40, 30, 20, 10, 0}));
 }
 
+
+TEST_F(SingleLinkedListTest, AllocatorReuseWithinSizeClass) {
+    // Блоки одного класса размеров взаимозаменяемы
+    CustomMemoryResource allocator;
+
+    void* ptr1 = allocator.allocate(100, 8);
+    allocator.deallocate(ptr1, 100, 8);
+
+    void* ptr2 = allocator.allocate(110, 8);
+    EXPECT_EQ(ptr1, ptr2) << "Block of the same size class should be reused";
+
+    // Маленький запрос не должен забирать блок большего класса
+    allocator.deallocate(ptr2, 110, 8);
+    void* small_ptr = allocator.allocate(16, 8);
+    EXPECT_NE(small_ptr, ptr1);
+
+    allocator.deallocate(small_ptr, 16, 8);
+}
+
+TEST_F(SingleLinkedListTest, AllocatorFreeListIsLifo) {
+    CustomMemoryResource allocator;
+
+    void* ptr1 = allocator.allocate(32, 8);
+    void* ptr2 = allocator.allocate(32, 8);
+    allocator.deallocate(ptr1, 32, 8);
+    allocator.deallocate(ptr2, 32, 8);
+
+    EXPECT_EQ(allocator.allocate(32, 8), ptr2);
+    EXPECT_EQ(allocator.allocate(32, 8), ptr1);
+}
+
+TEST_F(SingleLinkedListTest, AllocatorLargeBlocks) {
+    CustomMemoryResource allocator;
+
+    void* ptr = allocator.allocate(10000, 8);
+    EXPECT_NE(ptr, nullptr);
+    allocator.deallocate(ptr, 10000, 8);
+
+    // Освобождённый большой блок остаётся в кэше, повторное освобождение обнаруживается
+    EXPECT_THROW(allocator.deallocate(ptr, 10000, 8), std::logic_error);
+    EXPECT_EQ(allocator.allocate(9000, 8), ptr);
+}
+
+// Родительский ресурс, считающий обращения к себе
+class CountingResource : public std::pmr::memory_resource {
+public:
+    size_t allocations = 0;
+    size_t deallocations = 0;
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override {
+        ++deallocations;
+        std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+TEST_F(SingleLinkedListTest, SlabModeInvalidSize) {
+    EXPECT_THROW(CustomMemoryResource(nullptr, 1000), std::invalid_argument);
+    EXPECT_THROW(CustomMemoryResource(nullptr, 1024), std::invalid_argument);
+    EXPECT_NO_THROW(CustomMemoryResource(nullptr, 65536));
+}
+
+TEST_F(SingleLinkedListTest, SlabModeCarvesAdjacentSlots) {
+    CountingResource parent;
+    {
+        CustomMemoryResource allocator(&parent, 65536);
+        EXPECT_TRUE(allocator.slab_mode());
+
+        char* ptr1 = static_cast<char*>(allocator.allocate(16, 8));
+        char* ptr2 = static_cast<char*>(allocator.allocate(16, 8));
+        EXPECT_EQ(ptr1 + 16, ptr2) << "Consecutive slots should be adjacent";
+
+        allocator.deallocate(ptr1, 16, 8);
+        EXPECT_EQ(allocator.allocate(16, 8), ptr1) << "Freed slot should be reused";
+        EXPECT_EQ(parent.allocations, 1u);
+    }
+    EXPECT_EQ(parent.deallocations, parent.allocations);
+}
+
+TEST_F(SingleLinkedListTest, SlabModeListUsesFewParentAllocations) {
+    CountingResource parent;
+    {
+        CustomMemoryResource allocator(&parent, 65536);
+        SingleLinkedList<int> list(&allocator);
+        for (int i = 0; i < 1000; ++i) {
+            list.push_front(i);
+        }
+        EXPECT_EQ(list.size(), 1000u);
+        EXPECT_EQ(parent.allocations, 1u) << "1000 nodes of 16 bytes fit into one slab";
+    }
+    EXPECT_EQ(parent.deallocations, parent.allocations);
+}
+
+TEST_F(SingleLinkedListTest, SlabModeDoubleFreeAndUnknownPointer) {
+    CustomMemoryResource allocator(nullptr, 65536);
+
+    char* ptr = static_cast<char*>(allocator.allocate(64, 8));
+    allocator.deallocate(ptr, 64, 8);
+    EXPECT_THROW(allocator.deallocate(ptr, 64, 8), std::logic_error);
+
+    // Указатель внутрь слаба, не совпадающий с началом выданного слота
+    char* other = static_cast<char*>(allocator.allocate(64, 8));
+    EXPECT_NO_THROW(allocator.deallocate(other + 8, 64, 8));
+    allocator.deallocate(other, 64, 8);
+}
+
+TEST_F(SingleLinkedListTest, SlabModeAlignment) {
+    CustomMemoryResource allocator(nullptr, 65536);
+
+    void* ptr1 = allocator.allocate(24, 32);
+    void* ptr2 = allocator.allocate(64, 64);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr1) % 32, 0);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr2) % 64, 0);
+
+    allocator.deallocate(ptr1, 24, 32);
+    allocator.deallocate(ptr2, 64, 64);
+}
+
+TEST_F(SingleLinkedListTest, AddressMapInsertFindErase) {
+    AddressMap<int> map;
+    std::vector<int> storage(1000);
+
+    for (int i = 0; i < 1000; ++i) {
+        map.insert(&storage[i], i);
+    }
+    EXPECT_EQ(map.size(), 1000u);
+
+    // Удаляем каждый второй ключ; остальные должны оставаться доступными
+    for (int i = 0; i < 1000; i += 2) {
+        EXPECT_TRUE(map.erase(&storage[i]));
+    }
+    EXPECT_FALSE(map.erase(&storage[0]));
+    EXPECT_EQ(map.size(), 500u);
+
+    for (int i = 0; i < 1000; ++i) {
+        int* value = map.find(&storage[i]);
+        if (i % 2 == 0) {
+            EXPECT_EQ(value, nullptr);
+        } else {
+            ASSERT_NE(value, nullptr);
+            EXPECT_EQ(*value, i);
+        }
+    }
+}
+
+TEST_F(SingleLinkedListTest, AllocatorManyBlocksDoubleFree) {
+    CustomMemoryResource allocator;
+    std::vector<void*> blocks;
+
+    for (int i = 0; i < 500; ++i) {
+        blocks.push_back(allocator.allocate(16 << (i % 5), 8));
+    }
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        allocator.deallocate(blocks[i], 16 << (i % 5), 8);
+    }
+    for (size_t i = 0; i < blocks.size(); i += 50) {
+        EXPECT_THROW(allocator.deallocate(blocks[i], 16 << (i % 5), 8), std::logic_error);
+    }
+}
+
+// Тесты для ConcurrentMemoryResource
+TEST_F(SingleLinkedListTest, ConcurrentResourceReuseInThread) {
+    ConcurrentMemoryResource allocator;
+
+    void* ptr1 = allocator.allocate(100, 8);
+    allocator.deallocate(ptr1, 100, 8);
+    void* ptr2 = allocator.allocate(100, 8);
+    EXPECT_EQ(ptr1, ptr2) << "Thread cache should hand back the freed block";
+    allocator.deallocate(ptr2, 100, 8);
+
+    void* large = allocator.allocate(10000, 64);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(large) % 64, 0);
+    allocator.deallocate(large, 10000, 64);
+}
+
+TEST_F(SingleLinkedListTest, ConcurrentResourceListsOnWorkers) {
+    ConcurrentMemoryResource allocator;
+    constexpr int kThreads = 4;
+    constexpr int kElements = 10000;
+    std::vector<long long> sums(kThreads, 0);
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < kThreads; ++t) {
+        workers.emplace_back([&allocator, &sums, t] {
+            SingleLinkedList<int> list(&allocator);
+            for (int round = 0; round < 3; ++round) {
+                for (int i = 0; i < kElements; ++i) {
+                    list.push_front(i);
+                }
+                for (int i = 0; i < kElements / 2; ++i) {
+                    list.pop_front();
+                }
+            }
+            for (int value : list) {
+                sums[t] += value;
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    // В каждом списке по 3 раза осталась нижняя половина значений
+    long long expected = 3LL * (kElements / 2 - 1) * (kElements / 2) / 2;
+    for (long long sum : sums) {
+        EXPECT_EQ(sum, expected);
+    }
+}
+
+TEST_F(SingleLinkedListTest, ConcurrentResourceCrossThreadFree) {
+    ConcurrentMemoryResource allocator;
+    std::vector<void*> blocks;
+
+    std::thread producer([&] {
+        for (int i = 0; i < 1000; ++i) {
+            blocks.push_back(allocator.allocate(48, 8));
+        }
+    });
+    producer.join();
+
+    std::thread consumer([&] {
+        for (void* ptr : blocks) {
+            allocator.deallocate(ptr, 48, 8);
+        }
+        // Освобождённые блоки доступны для повторной выдачи в этом потоке
+        EXPECT_EQ(allocator.allocate(48, 8), blocks.back());
+        allocator.deallocate(blocks.back(), 48, 8);
+    });
+    consumer.join();
+}
+
+TEST_F(SingleLinkedListTest, ConcurrentResourceOutlivedByThreadCache) {
+    // Кэш главного потока для уничтоженного ресурса не должен мешать новому
+    for (int i = 0; i < 3; ++i) {
+        ConcurrentMemoryResource allocator;
+        SingleLinkedList<std::string> list(&allocator);
+        list.push_front("value");
+        list.pop_front();
+        list.push_front("again");
+        EXPECT_EQ(list.front(), "again");
+    }
+}
+
+// Тесты для ConcurrentSingleLinkedList
+TEST_F(SingleLinkedListTest, ConcurrentListLifoOrder) {
+    ConcurrentSingleLinkedList<std::string> stack(resource.get());
+
+    stack.push_front("first");
+    stack.emplace_front(3, 'x');
+    EXPECT_EQ(stack.size(), 2u);
+
+    std::string value;
+    ASSERT_TRUE(stack.try_pop_front(value));
+    EXPECT_EQ(value, "xxx");
+    ASSERT_TRUE(stack.try_pop_front(value));
+    EXPECT_EQ(value, "first");
+    EXPECT_FALSE(stack.try_pop_front(value));
+    EXPECT_TRUE(stack.empty());
+}
+
+TEST_F(SingleLinkedListTest, ConcurrentListProducersConsumers) {
+    ConcurrentMemoryResource allocator;
+    ConcurrentSingleLinkedList<int> stack(&allocator);
+    constexpr int kProducers = 4;
+    constexpr int kConsumers = 4;
+    constexpr int kPerProducer = 20000;
+    constexpr int kTotal = kProducers * kPerProducer;
+
+    std::vector<std::atomic<int>> seen(kTotal);
+    std::atomic<int> popped{0};
+    std::vector<std::thread> threads;
+
+    for (int p = 0; p < kProducers; ++p) {
+        threads.emplace_back([&stack, p] {
+            for (int i = 0; i < kPerProducer; ++i) {
+                stack.push_front(p * kPerProducer + i);
+            }
+        });
+    }
+    for (int c = 0; c < kConsumers; ++c) {
+        threads.emplace_back([&] {
+            int value;
+            while (popped.load() < kTotal) {
+                if (stack.try_pop_front(value)) {
+                    seen[value].fetch_add(1);
+                    popped.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_TRUE(stack.empty());
+    for (int i = 0; i < kTotal; ++i) {
+        ASSERT_EQ(seen[i].load(), 1) << "value " << i;
+    }
+}
+
+// Диагностика аномалий
+TEST_F(SingleLinkedListTest, AllocatorAnomalyHandler) {
+    CustomMemoryResource allocator;
+    std::vector<AnomalyEvent> events;
+    allocator.set_anomaly_handler([](const AnomalyEvent& event, void* context) {
+        static_cast<std::vector<AnomalyEvent>*>(context)->push_back(event);
+    }, &events);
+
+    int dummy;
+    allocator.deallocate(&dummy, 4, 4);
+
+    void* ptr = allocator.allocate(100, 8);
+    allocator.deallocate(ptr, 100, 8);
+    EXPECT_THROW(allocator.deallocate(ptr, 100, 8), std::logic_error);
+
+    ASSERT_EQ(events.size(), 2u);
+    EXPECT_EQ(events[0].kind, AllocationAnomaly::UnknownPointer);
+    EXPECT_EQ(events[0].ptr, &dummy);
+    EXPECT_EQ(events[1].kind, AllocationAnomaly::DoubleFree);
+    EXPECT_EQ(events[1].bytes, 100u);
+    EXPECT_EQ(allocator.anomaly_count(AllocationAnomaly::DoubleFree), 1u);
+}
+
+TEST_F(SingleLinkedListTest, AllocatorSizeAndAlignmentMismatch) {
+    CustomMemoryResource allocator(nullptr, 65536);
+
+    void* ptr1 = allocator.allocate(32, 8);
+    allocator.deallocate(ptr1, 200, 8);
+    EXPECT_EQ(allocator.anomaly_count(AllocationAnomaly::SizeMismatch), 1u);
+
+    void* ptr2 = allocator.allocate(32, 8);
+    allocator.deallocate(ptr2, 32, 256);
+    EXPECT_EQ(allocator.anomaly_count(AllocationAnomaly::AlignmentMismatch), 1u);
+
+    void* large = allocator.allocate(10000, 8);
+    allocator.deallocate(large, 9000, 8);
+    EXPECT_EQ(allocator.anomaly_count(AllocationAnomaly::SizeMismatch), 2u);
+}
+
+TEST_F(SingleLinkedListTest, AllocatorAnomalyRingBuffer) {
+    CustomMemoryResource allocator;
+    AnomalyLog<2> log;
+    allocator.set_anomaly_log(log);
+
+    int dummies[3];
+    for (int& dummy : dummies) {
+        allocator.deallocate(&dummy, sizeof(int), alignof(int));
+    }
+
+    EXPECT_EQ(log.total(), 3u);
+    EXPECT_EQ(log.size(), 2u);
+    EXPECT_EQ(log.dropped(), 1u);
+    EXPECT_EQ(log[0].ptr, &dummies[1]);
+    EXPECT_EQ(log[1].ptr, &dummies[2]);
+}
+
+// Статистика аллокатора
+TEST_F(SingleLinkedListTest, AllocatorStatsCountReuse) {
+    CustomMemoryResource allocator;
+
+    void* ptr1 = allocator.allocate(100, 8);
+    void* ptr2 = allocator.allocate(20, 16);
+    allocator.deallocate(ptr1, 100, 8);
+    void* ptr3 = allocator.allocate(100, 8);
+
+    auto stats = allocator.stats();
+    EXPECT_EQ(stats.allocations, 3u);
+    EXPECT_EQ(stats.deallocations, 1u);
+    EXPECT_EQ(stats.reuse_hits, 1u);
+    EXPECT_EQ(stats.parent_fallbacks, 2u);
+    EXPECT_EQ(stats.blocks_from_parent, 2u);
+    EXPECT_EQ(stats.bytes_from_parent, 112u + 32u);
+    EXPECT_EQ(stats.blocks_live, 2u);
+    EXPECT_EQ(stats.bytes_live, 112u + 32u);
+    EXPECT_EQ(stats.bytes_requested_live, 100u + 20u);
+    EXPECT_EQ(stats.peak_bytes_live, 112u + 32u);
+    EXPECT_DOUBLE_EQ(stats.reuse_hit_rate(), 1.0 / 3.0);
+
+    EXPECT_EQ(stats.size_histogram[CustomMemoryResource::size_class_index(112, 1)], 2u);
+    EXPECT_EQ(stats.size_histogram[CustomMemoryResource::size_class_index(32, 1)], 1u);
+    EXPECT_EQ(stats.alignment_histogram[3], 2u);
+    EXPECT_EQ(stats.alignment_histogram[4], 1u);
+
+    allocator.deallocate(ptr2, 20, 16);
+    allocator.deallocate(ptr3, 100, 8);
+    stats = allocator.stats();
+    EXPECT_EQ(stats.bytes_live, 0u);
+    EXPECT_EQ(stats.peak_bytes_live, 112u + 32u);
+}
+
+TEST_F(SingleLinkedListTest, AllocatorStatsSlabModeAndLargeBlocks) {
+    CustomMemoryResource allocator(nullptr, 65536);
+    {
+        SingleLinkedList<int> list(&allocator);
+        for (int i = 0; i < 100; ++i) {
+            list.push_front(i);
+        }
+        auto stats = allocator.stats();
+        EXPECT_EQ(stats.parent_fallbacks, 1u);
+        EXPECT_EQ(stats.bytes_from_parent, 65536u);
+        EXPECT_EQ(stats.blocks_live, 100u);
+    }
+
+    void* large = allocator.allocate(10000, 8);
+    auto stats = allocator.stats();
+    EXPECT_EQ(stats.size_histogram[CustomMemoryResource::kSizeClassCount], 1u);
+    EXPECT_EQ(stats.bytes_from_parent, 65536u + 10000u);
+
+    allocator.deallocate(large, 10000, 8);
+    allocator.trim(65536);
+    stats = allocator.stats();
+    EXPECT_EQ(stats.bytes_from_parent, 65536u);
+    EXPECT_EQ(stats.peak_bytes_from_parent, 65536u + 10000u);
+    EXPECT_EQ(stats.blocks_live, 0u);
+}
+
+TEST_F(SingleLinkedListTest, AllocatorStatsReadFromAnotherThread) {
+    CustomMemoryResource allocator(nullptr, 65536);
+    std::atomic<bool> done{false};
+
+    std::thread reader([&] {
+        size_t last = 0;
+        while (!done.load()) {
+            size_t now = allocator.stats().allocations;
+            EXPECT_GE(now, last);
+            last = now;
+        }
+    });
+    {
+        SingleLinkedList<int> list(&allocator);
+        for (int i = 0; i < 10000; ++i) {
+            list.push_front(i);
+        }
+    }
+    done.store(true);
+    reader.join();
+
+    EXPECT_EQ(allocator.stats().allocations, 10000u);
+}
+
+// Возврат памяти родителю
+TEST_F(SingleLinkedListTest, AllocatorTrimPerBlockMode) {
+    CountingResource parent;
+    CustomMemoryResource allocator(&parent);
+
+    std::vector<void*> blocks;
+    for (int i = 0; i < 10; ++i) {
+        blocks.push_back(allocator.allocate(64, 8));
+    }
+    for (int i = 0; i < 8; ++i) {
+        allocator.deallocate(blocks[i], 64, 8);
+    }
+    EXPECT_EQ(allocator.retained(), 8u * 64u);
+
+    allocator.trim(3 * 64);
+    EXPECT_EQ(allocator.retained(), 3u * 64u);
+    EXPECT_EQ(parent.deallocations, 5u);
+
+    allocator.trim();
+    EXPECT_EQ(allocator.retained(), 0u);
+    EXPECT_EQ(allocator.stats().blocks_live, 2u);
+
+    // Освобождённые родителю блоки больше не известны ресурсу
+    allocator.deallocate(blocks[0], 64, 8);
+    EXPECT_EQ(allocator.anomaly_count(AllocationAnomaly::UnknownPointer), 1u);
+}
+
+TEST_F(SingleLinkedListTest, AllocatorTrimSlabMode) {
+    CountingResource parent;
+    CustomMemoryResource allocator(&parent, 4096);
+    SingleLinkedList<int> keep(&allocator);
+    keep.push_front(42);
+    {
+        SingleLinkedList<int> list(&allocator);
+        for (int i = 0; i < 2000; ++i) {
+            list.push_front(i);
+        }
+        EXPECT_GT(allocator.stats().blocks_from_parent, 7u);
+    }
+
+    allocator.trim();
+    // Остаётся только слаб с живым узлом
+    EXPECT_EQ(allocator.stats().blocks_from_parent, 1u);
+    EXPECT_EQ(keep.front(), 42);
+
+    // После обрезки ресурс продолжает работать
+    SingleLinkedList<int> again(&allocator);
+    for (int i = 0; i < 1000; ++i) {
+        again.push_front(i);
+    }
+    EXPECT_EQ(again.size(), 1000u);
+}
+
+TEST_F(SingleLinkedListTest, AllocatorRelease) {
+    CountingResource parent;
+    CustomMemoryResource allocator(&parent, 65536);
+
+    void* small_ptr = allocator.allocate(32, 8);
+    void* large_ptr = allocator.allocate(10000, 8);
+    EXPECT_NE(small_ptr, large_ptr);
+    allocator.release();
+
+    EXPECT_EQ(parent.deallocations, parent.allocations);
+    EXPECT_EQ(allocator.stats().bytes_from_parent, 0u);
+    EXPECT_EQ(allocator.stats().bytes_live, 0u);
+
+    void* ptr = allocator.allocate(32, 8);
+    allocator.deallocate(ptr, 32, 8);
+}
+
+TEST_F(SingleLinkedListTest, AllocatorRetentionLimit) {
+    CountingResource parent;
+    CustomMemoryResource allocator(&parent, 4096);
+    allocator.set_retention_limit(4 * 4096);
+
+    SingleLinkedList<int> list(&allocator);
+    for (int i = 0; i < 10000; ++i) {
+        list.push_front(i);
+    }
+    size_t peak = allocator.stats().bytes_from_parent;
+
+    while (list.size() > 10) {
+        list.pop_front();
+    }
+    EXPECT_LE(allocator.retained(), 4u * 4096u + 4096u);
+    EXPECT_LT(allocator.stats().bytes_from_parent, peak / 4);
+}
+
+TEST_F(SingleLinkedListTest, ConcurrentResourceTrim) {
+    CountingResource parent;
+    ConcurrentMemoryResource allocator(&parent, 4096);
+
+    std::thread worker([&] {
+        SingleLinkedList<int> list(&allocator);
+        for (int i = 0; i < 5000; ++i) {
+            list.push_front(i);
+        }
+    });
+    worker.join();
+
+    // Кэш завершившегося потока уже сброшен в общий пул
+    allocator.trim();
+    EXPECT_EQ(allocator.pool_stats().bytes_from_parent, 0u);
+}
+
+// Классы размеров и выбор наилучшего подходящего блока
+TEST_F(SingleLinkedListTest, SizeClassesAreTightAndAligned) {
+    using R = CustomMemoryResource;
+    for (size_t alignment = 1; alignment <= R::kMaxSmallBlockSize; alignment *= 2) {
+        for (size_t bytes = 1; bytes <= R::kMaxSmallBlockSize; ++bytes) {
+            size_t index = R::size_class_index(bytes, alignment);
+            if (index == R::kSizeClassCount) {
+                ASSERT_GT((bytes + alignment - 1) / alignment * alignment, R::kMaxSmallBlockSize);
+                continue;
+            }
+            size_t size = R::size_class_size(index);
+            ASSERT_GE(size, bytes);
+            ASSERT_EQ(size % alignment, 0u) << bytes << " " << alignment;
+            ASSERT_GE(R::size_class_alignment(index), alignment);
+            // Более мелкий подходящий класс не пропущен
+            for (size_t smaller = 0; smaller < index; ++smaller) {
+                size_t candidate = R::size_class_size(smaller);
+                ASSERT_FALSE(candidate >= bytes && candidate % alignment == 0);
+            }
+        }
+    }
+    // Потери на округление не больше четверти для запросов от 64 байт
+    for (size_t bytes = 64; bytes <= R::kMaxSmallBlockSize; ++bytes) {
+        ASSERT_LE(R::size_class_size(R::size_class_index(bytes, 1)) * 4, bytes * 5 + 64);
+    }
+}
+
+TEST_F(SingleLinkedListTest, AllocatorLargeBlocksBestFit) {
+    CustomMemoryResource allocator;
+
+    void* huge = allocator.allocate(64 * 1024, 8);
+    void* medium = allocator.allocate(20000, 8);
+    allocator.deallocate(huge, 64 * 1024, 8);
+    allocator.deallocate(medium, 20000, 8);
+
+    // Берётся наименьший подходящий блок, а не первый попавшийся
+    EXPECT_EQ(allocator.allocate(18000, 8), medium);
+
+    // Слишком большой блок не тратится на небольшой запрос
+    void* small_large = allocator.allocate(8000, 8);
+    EXPECT_NE(small_large, huge);
+    EXPECT_EQ(allocator.allocate(60000, 8), huge);
+}
+
+TEST_F(SingleLinkedListTest, AllocatorFragmentationMetric) {
+    CustomMemoryResource allocator;
+
+    void* ptr1 = allocator.allocate(65, 8);   // класс 80
+    void* ptr2 = allocator.allocate(80, 8);
+    auto stats = allocator.stats();
+    EXPECT_EQ(stats.bytes_live, 160u);
+    EXPECT_DOUBLE_EQ(stats.internal_fragmentation(), 1.0 - 145.0 / 160.0);
+    EXPECT_DOUBLE_EQ(stats.external_fragmentation(), 0.0);
+
+    allocator.deallocate(ptr2, 80, 8);
+    stats = allocator.stats();
+    EXPECT_DOUBLE_EQ(stats.external_fragmentation(), 0.5);
+    allocator.deallocate(ptr1, 65, 8);
+}
+
+// Конструирование элементов на месте
+struct ConstructionCounter {
+    static inline int constructions = 0;
+    static inline int copies = 0;
+    static inline int moves = 0;
+
+    int id;
+    std::string name;
+
+    ConstructionCounter(int i, std::string n) : id(i), name(std::move(n)) { ++constructions; }
+    ConstructionCounter(const ConstructionCounter& other) : id(other.id), name(other.name) { ++copies; }
+    ConstructionCounter(ConstructionCounter&& other) noexcept : id(other.id), name(std::move(other.name)) { ++moves; }
+
+    static void reset() { constructions = copies = moves = 0; }
+};
+
+TEST_F(SingleLinkedListTest, EmplaceFrontConstructsInPlace) {
+    SingleLinkedList<ConstructionCounter> list(resource.get());
+    ConstructionCounter::reset();
+
+    auto& ref = list.emplace_front(1, "a string that does not fit into the small buffer");
+    list.emplace_front(2, "second");
+
+    EXPECT_EQ(&ref, &*(++list.begin()));
+    EXPECT_EQ(list.front().id, 2);
+    EXPECT_EQ(ConstructionCounter::constructions, 2);
+    EXPECT_EQ(ConstructionCounter::copies, 0);
+    EXPECT_EQ(ConstructionCounter::moves, 0);
+}
+
+TEST_F(SingleLinkedListTest, EmplaceAfter) {
+    SingleLinkedList<ConstructionCounter> list(resource.get());
+    ConstructionCounter::reset();
+
+    auto first = list.emplace_after(list.before_begin(), 1, "one");
+    auto third = list.emplace_after(first, 3, "three");
+    list.emplace_after(first, 2, "two");
+
+    std::vector<int> ids;
+    for (const auto& item : list) {
+        ids.push_back(item.id);
+    }
+    EXPECT_EQ(ids, std::vector<int>({1, 2, 3}));
+    EXPECT_EQ(third->name, "three");
+    EXPECT_EQ(list.size(), 3u);
+    EXPECT_EQ(ConstructionCounter::copies + ConstructionCounter::moves, 0);
+}
+
+// Массовая вставка
+TEST_F(SingleLinkedListTest, RangeConstructorKeepsOrder) {
+    std::vector<int> values = {1, 2, 3, 4, 5};
+    SingleLinkedList<int> list(values.begin(), values.end(), resource.get());
+
+    EXPECT_EQ(list.size(), 5u);
+    EXPECT_EQ(std::vector<int>(list.begin(), list.end()), values);
+    EXPECT_EQ(list.get_allocator().resource(), resource.get());
+
+    SingleLinkedList<std::string> copies(3, "x", resource.get());
+    EXPECT_EQ(std::vector<std::string>(copies.begin(), copies.end()), std::vector<std::string>(3, "x"));
+}
+
+TEST_F(SingleLinkedListTest, RangeInsertAfter) {
+    SingleLinkedList<int> list(resource.get());
+    list.push_front(9);
+    list.push_front(1);
+
+    std::vector<int> middle = {2, 3, 4};
+    auto last = list.insert_after(list.begin(), middle.begin(), middle.end());
+    EXPECT_EQ(*last, 4);
+
+    auto front = list.insert_after(list.before_begin(), 2, 0);
+    EXPECT_EQ(*front, 0);
+    auto unchanged = list.insert_after(list.begin(), middle.end(), middle.end());
+    EXPECT_EQ(unchanged, list.begin());
+
+    EXPECT_EQ(std::vector<int>(list.begin(), list.end()), std::vector<int>({0, 0, 1, 2, 3, 4, 9}));
+    EXPECT_EQ(list.size(), 7u);
+}
+
+TEST_F(SingleLinkedListTest, AssignReplacesContents) {
+    SingleLinkedList<int> list(resource.get());
+    list.push_front(42);
+
+    std::istringstream input("5 6 7");
+    list.assign(std::istream_iterator<int>(input), std::istream_iterator<int>());
+    EXPECT_EQ(std::vector<int>(list.begin(), list.end()), std::vector<int>({5, 6, 7}));
+
+    list.assign(2, 8);
+    EXPECT_EQ(std::vector<int>(list.begin(), list.end()), std::vector<int>({8, 8}));
+    EXPECT_EQ(resource->stats().blocks_live, 2u);
+}
+
+TEST_F(SingleLinkedListTest, BulkInsertCarvesContiguousSlots) {
+    CustomMemoryResource slab_resource(nullptr, 64 * 1024);
+    std::vector<int> values(1000);
+    for (int i = 0; i < 1000; ++i) values[i] = i;
+
+    SingleLinkedList<int> list(values.begin(), values.end(), &slab_resource);
+
+    size_t adjacent = 0;
+    const int* previous = nullptr;
+    for (const int& value : list) {
+        if (previous && reinterpret_cast<const char*>(&value) > reinterpret_cast<const char*>(previous)) {
+            ++adjacent;
+        }
+        previous = &value;
+    }
+    EXPECT_EQ(adjacent, 999u);
+    EXPECT_EQ(slab_resource.stats().blocks_from_parent, 1u);
+
+    list.clear();
+    EXPECT_EQ(slab_resource.stats().blocks_live, 0u);
+}
+
+struct ThrowingCopy {
+    static inline int until_throw = 0;
+    int value;
+    ThrowingCopy(int v) : value(v) {}
+    ThrowingCopy(const ThrowingCopy& other) : value(other.value) {
+        if (--until_throw == 0) throw std::runtime_error("copy failed");
+    }
+};
+
+TEST_F(SingleLinkedListTest, BulkInsertIsExceptionSafe) {
+    CustomMemoryResource slab_resource(nullptr, 64 * 1024);
+    SingleLinkedList<ThrowingCopy> list(&slab_resource);
+    list.emplace_front(-1);
+
+    std::vector<ThrowingCopy> values;
+    for (int i = 0; i < 100; ++i) values.emplace_back(i);
+
+    ThrowingCopy::until_throw = 70;
+    EXPECT_THROW(list.insert_after(list.begin(), values.begin(), values.end()), std::runtime_error);
+    ThrowingCopy::until_throw = 70;
+    EXPECT_THROW(list.assign(values.begin(), values.end()), std::runtime_error);
+
+    EXPECT_EQ(list.size(), 1u);
+    EXPECT_EQ(list.front().value, -1);
+    EXPECT_EQ(slab_resource.stats().blocks_live, 1u);
+}
+
+// Режим с хвостом
+using TailList = SingleLinkedList<int, TailTrackingPolicy>;
+
+TEST_F(SingleLinkedListTest, HeadOnlyLayoutIsUnchanged) {
+    EXPECT_EQ(sizeof(SingleLinkedList<int>), 2 * sizeof(void*) + sizeof(std::pmr::polymorphic_allocator<int>));
+    EXPECT_EQ(sizeof(TailList), sizeof(SingleLinkedList<int>) + sizeof(void*));
+}
+
+TEST_F(SingleLinkedListTest, PushBackKeepsFifoOrder) {
+    TailList list(resource.get());
+    for (int i = 0; i < 5; ++i) {
+        list.push_back(i);
+        EXPECT_EQ(list.back(), i);
+    }
+    list.emplace_back(5);
+    EXPECT_EQ(std::vector<int>(list.begin(), list.end()), std::vector<int>({0, 1, 2, 3, 4, 5}));
+    EXPECT_EQ(list.front(), 0);
+    EXPECT_EQ(list.back(), 5);
+}
+
+TEST_F(SingleLinkedListTest, TailFollowsModifications) {
+    TailList list(resource.get());
+    EXPECT_THROW(list.back(), std::logic_error);
+
+    list.push_front(2);
+    EXPECT_EQ(list.back(), 2);
+    list.insert_after(list.begin(), 3);
+    EXPECT_EQ(list.back(), 3);
+    list.erase_after(list.begin());
+    EXPECT_EQ(list.back(), 2);
+
+    std::vector<int> tail_values = {4, 5};
+    list.insert_after(list.begin(), tail_values.begin(), tail_values.end());
+    EXPECT_EQ(list.back(), 5);
+
+    list.pop_front();
+    list.pop_front();
+    list.pop_front();
+    EXPECT_TRUE(list.empty());
+    list.push_back(7);
+    EXPECT_EQ(list.front(), 7);
+    EXPECT_EQ(list.back(), 7);
+
+    list.assign(3, 1);
+    list.push_back(9);
+    EXPECT_EQ(std::vector<int>(list.begin(), list.end()), std::vector<int>({1, 1, 1, 9}));
+
+    TailList copy(list);
+    copy.push_back(10);
+    EXPECT_EQ(copy.back(), 10);
+    EXPECT_EQ(list.back(), 9);
+
+    TailList moved(std::move(copy));
+    moved.push_back(11);
+    EXPECT_EQ(moved.size(), 6u);
+    EXPECT_EQ(moved.back(), 11);
+    copy.push_back(1);
+    EXPECT_EQ(copy.front(), 1);
+
+    swap(list, moved);
+    EXPECT_EQ(list.back(), 11);
+    EXPECT_EQ(moved.back(), 9);
+
+    list.clear();
+    list.push_back(3);
+    EXPECT_EQ(list.front(), 3);
+}
+
+TEST_F(SingleLinkedListTest, SpliceBack) {
+    TailList list(resource.get());
+    TailList other(resource.get());
+    list.push_back(1);
+    other.push_back(2);
+    other.push_back(3);
+
+    list.splice_back(other);
+    EXPECT_TRUE(other.empty());
+    EXPECT_EQ(list.size(), 3u);
+    EXPECT_EQ(list.back(), 3);
+
+    TailList empty(resource.get());
+    empty.splice_back(list);
+    EXPECT_EQ(std::vector<int>(empty.begin(), empty.end()), std::vector<int>({1, 2, 3}));
+    empty.push_back(4);
+    EXPECT_EQ(empty.back(), 4);
+
+    CustomMemoryResource other_resource;
+    TailList foreign(&other_resource);
+    foreign.push_back(5);
+    EXPECT_THROW(empty.splice_back(foreign), std::logic_error);
+    EXPECT_EQ(foreign.size(), 1u);
+}
+
+// Развёрнутый список
+TEST_F(SingleLinkedListTest, UnrolledBasicOperations) {
+    UnrolledSingleLinkedList<int, 4> list(resource.get());
+    EXPECT_TRUE(list.empty());
+    EXPECT_THROW(list.front(), std::logic_error);
+    EXPECT_THROW(list.pop_front(), std::logic_error);
+
+    for (int i = 9; i >= 0; --i) {
+        list.push_front(i);
+    }
+    EXPECT_EQ(list.size(), 10u);
+    EXPECT_EQ(list.front(), 0);
+    EXPECT_EQ(std::vector<int>(list.begin(), list.end()), std::vector<int>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+
+    auto it = list.insert_after(list.begin(), 100);
+    EXPECT_EQ(*it, 100);
+    EXPECT_EQ(*list.erase_after(list.begin()), 1);
+    list.pop_front();
+    EXPECT_EQ(list.front(), 1);
+
+    list.clear();
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(resource->stats().blocks_live, 0u);
+}
+
+TEST_F(SingleLinkedListTest, UnrolledMatchesReferenceList) {
+    UnrolledSingleLinkedList<std::string, 3> list(resource.get());
+    std::list<std::string> reference;
+    std::mt19937 rng(7);
+
+    for (int step = 0; step < 3000; ++step) {
+        size_t position = reference.empty() ? 0 : rng() % (reference.size() + 1);
+        auto it = list.before_begin();
+        auto ref_it = reference.begin();
+        for (size_t i = 0; i < position; ++i) {
+            it = (i == 0) ? list.begin() : std::next(it);
+            ++ref_it;
+        }
+        if (rng() % 3 != 0 || reference.empty()) {
+            std::string value = std::to_string(step) + " - long enough to leave the small string buffer";
+            EXPECT_EQ(*list.insert_after(it, value), value);
+            reference.insert(ref_it, value);
+        } else if (position < reference.size()) {
+            list.erase_after(it);
+            reference.erase(ref_it);
+        }
+        ASSERT_EQ(list.size(), reference.size());
+    }
+    EXPECT_TRUE(std::equal(list.begin(), list.end(), reference.begin(), reference.end()));
+
+    auto copy = list;
+    EXPECT_TRUE(std::equal(copy.begin(), copy.end(), reference.begin(), reference.end()));
+
+    CustomMemoryResource other_resource;
+    UnrolledSingleLinkedList<std::string, 3> moved(&other_resource);
+    moved = std::move(copy);
+    EXPECT_TRUE(copy.empty());
+    EXPECT_TRUE(std::equal(moved.begin(), moved.end(), reference.begin(), reference.end()));
+}
+
+TEST_F(SingleLinkedListTest, UnrolledRangeConstructorPacksNodes) {
+    std::vector<int> values(1000);
+    for (int i = 0; i < 1000; ++i) values[i] = i;
+
+    using List = UnrolledSingleLinkedList<int>;
+    List list(values.begin(), values.end(), resource.get());
+    size_t expected_nodes = (values.size() + List::node_capacity - 1) / List::node_capacity;
+
+    EXPECT_EQ(std::vector<int>(list.begin(), list.end()), values);
+    EXPECT_EQ(resource->stats().blocks_live, expected_nodes);
+    EXPECT_EQ(std::accumulate(list.begin(), list.end(), 0L), 999L * 1000 / 2);
+}
+
+TEST_F(SingleLinkedListTest, UnrolledAppendAfterLastKeepsNodesFull) {
+    UnrolledSingleLinkedList<int, 8> list(resource.get());
+    auto it = list.insert_after(list.before_begin(), 0);
+    for (int i = 1; i < 64; ++i) {
+        it = list.insert_after(it, i);
+    }
+    EXPECT_EQ(resource->stats().blocks_live, 8u);
+    EXPECT_EQ(list.size(), 64u);
+}
+
+// Перестановка узлов без аллокатора
+template <typename List>
+std::vector<typename List::value_type> to_vector(const List& list) {
+    return std::vector<typename List::value_type>(list.begin(), list.end());
+}
+
+TEST_F(SingleLinkedListTest, SpliceAfterMovesNodes) {
+    std::vector<int> a_values = {1, 2, 3};
+    std::vector<int> b_values = {10, 20, 30, 40};
+    SingleLinkedList<int> a(a_values.begin(), a_values.end(), resource.get());
+    SingleLinkedList<int> b(b_values.begin(), b_values.end(), resource.get());
+    const int* moved_address = &*std::next(b.begin());
+    size_t allocations = resource->stats().allocations;
+
+    a.splice_after(a.begin(), b, b.begin());
+    EXPECT_EQ(to_vector(a), std::vector<int>({1, 20, 2, 3}));
+    EXPECT_EQ(to_vector(b), std::vector<int>({10, 30, 40}));
+    EXPECT_EQ(&*std::next(a.begin()), moved_address);
+
+    a.splice_after(a.before_begin(), b, b.before_begin(), std::next(b.begin(), 2));
+    EXPECT_EQ(to_vector(a), std::vector<int>({10, 30, 1, 20, 2, 3}));
+    EXPECT_EQ(to_vector(b), std::vector<int>({40}));
+
+    a.splice_after(a.before_begin(), b);
+    EXPECT_EQ(to_vector(a), std::vector<int>({40, 10, 30, 1, 20, 2, 3}));
+    EXPECT_TRUE(b.empty());
+    EXPECT_EQ(a.size(), 7u);
+
+    // Перенос внутри одного списка
+    a.splice_after(a.before_begin(), a, std::next(a.begin(), 5));
+    EXPECT_EQ(to_vector(a), std::vector<int>({3, 40, 10, 30, 1, 20, 2}));
+    a.splice_after(a.begin(), a, a.before_begin());
+    EXPECT_EQ(to_vector(a), std::vector<int>({3, 40, 10, 30, 1, 20, 2}));
+
+    EXPECT_EQ(resource->stats().allocations, allocations);
+
+    CustomMemoryResource other_resource;
+    SingleLinkedList<int> foreign(&other_resource);
+    foreign.push_front(1);
+    EXPECT_THROW(a.splice_after(a.begin(), foreign), std::logic_error);
+    EXPECT_THROW(a.merge(foreign), std::logic_error);
+}
+
+TEST_F(SingleLinkedListTest, SpliceAfterMaintainsTail) {
+    std::vector<int> values = {1, 2, 3};
+    TailList a(values.begin(), values.end(), resource.get());
+    TailList b(values.begin(), values.end(), resource.get());
+
+    a.splice_after(std::next(a.begin(), 2), b, b.begin(), b.end());
+    EXPECT_EQ(to_vector(a), std::vector<int>({1, 2, 3, 2, 3}));
+    EXPECT_EQ(a.back(), 3);
+    EXPECT_EQ(b.back(), 1);
+    b.push_back(4);
+    a.push_back(5);
+    EXPECT_EQ(to_vector(b), std::vector<int>({1, 4}));
+    EXPECT_EQ(to_vector(a), std::vector<int>({1, 2, 3, 2, 3, 5}));
+
+    a.splice_after(a.before_begin(), b, b.begin());
+    EXPECT_EQ(b.back(), 1);
+    EXPECT_EQ(a.front(), 4);
+}
+
+TEST_F(SingleLinkedListTest, MergeIsStable) {
+    using Pair = std::pair<int, char>;
+    std::vector<Pair> a_values = {{1, 'a'}, {3, 'a'}, {5, 'a'}};
+    std::vector<Pair> b_values = {{1, 'b'}, {2, 'b'}, {5, 'b'}, {7, 'b'}};
+    SingleLinkedList<Pair, TailTrackingPolicy> a(a_values.begin(), a_values.end(), resource.get());
+    SingleLinkedList<Pair, TailTrackingPolicy> b(b_values.begin(), b_values.end(), resource.get());
+
+    a.merge(b, [](const Pair& lhs, const Pair& rhs) { return lhs.first < rhs.first; });
+    std::vector<Pair> expected = {{1, 'a'}, {1, 'b'}, {2, 'b'}, {3, 'a'}, {5, 'a'}, {5, 'b'}, {7, 'b'}};
+    EXPECT_EQ(to_vector(a), expected);
+    EXPECT_EQ(a.back(), Pair(7, 'b'));
+    EXPECT_TRUE(b.empty());
+    b.push_back({0, 'c'});
+    EXPECT_EQ(b.size(), 1u);
+}
+
+TEST_F(SingleLinkedListTest, SortRelinksNodesStably) {
+    std::mt19937 rng(11);
+    std::vector<std::pair<int, int>> values;
+    for (int i = 0; i < 1000; ++i) {
+        values.emplace_back(static_cast<int>(rng() % 50), i);
+    }
+    SingleLinkedList<std::pair<int, int>, TailTrackingPolicy> list(values.begin(), values.end(), resource.get());
+    std::set<const void*> addresses;
+    for (const auto& item : list) addresses.insert(&item);
+    size_t allocations = resource->stats().allocations;
+
+    auto by_key = [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; };
+    list.sort(by_key);
+    std::stable_sort(values.begin(), values.end(), by_key);
+
+    EXPECT_EQ(to_vector(list), values);
+    EXPECT_EQ(list.back(), values.back());
+    EXPECT_EQ(resource->stats().allocations, allocations);
+    for (const auto& item : list) EXPECT_TRUE(addresses.count(&item));
+
+    SingleLinkedList<int> small(resource.get());
+    small.sort();
+    small.push_front(1);
+    small.sort();
+    EXPECT_EQ(small.front(), 1);
+}
+
+TEST_F(SingleLinkedListTest, ReverseUniqueRemoveIf) {
+    std::vector<int> values = {1, 1, 2, 3, 3, 3, 4, 1};
+    TailList list(values.begin(), values.end(), resource.get());
+
+    list.reverse();
+    EXPECT_EQ(to_vector(list), std::vector<int>({1, 4, 3, 3, 3, 2, 1, 1}));
+    EXPECT_EQ(list.back(), 1);
+
+    EXPECT_EQ(list.unique(), 3u);
+    EXPECT_EQ(to_vector(list), std::vector<int>({1, 4, 3, 2, 1}));
+    EXPECT_EQ(list.size(), 5u);
+
+    EXPECT_EQ(list.remove_if([](int value) { return value % 2 == 1; }), 3u);
+    EXPECT_EQ(to_vector(list), std::vector<int>({4, 2}));
+    EXPECT_EQ(list.back(), 2);
+
+    EXPECT_EQ(list.remove(list.front()), 1u);
+    EXPECT_EQ(to_vector(list), std::vector<int>({2}));
+    EXPECT_EQ(list.remove(2), 1u);
+    EXPECT_TRUE(list.empty());
+    list.push_back(8);
+    EXPECT_EQ(list.front(), 8);
+    EXPECT_EQ(resource->stats().blocks_live, 1u);
+}
+
+// Быстрое уничтожение
+// Арена: память отдаётся только при уничтожении ресурса, deallocate лишь считается
+class CountingArena : public BatchMemoryResource {
+public:
+    size_t deallocations = 0;
+
+    ~CountingArena() override {
+        for (auto& block : blocks) {
+            std::pmr::new_delete_resource()->deallocate(block.first, block.second.first, block.second.second);
+        }
+    }
+
+private:
+    std::vector<std::pair<void*, std::pair<size_t, size_t>>> blocks;
+
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        void* ptr = std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        blocks.push_back({ptr, {bytes, alignment}});
+        return ptr;
+    }
+
+    void do_deallocate(void*, size_t, size_t) override { ++deallocations; }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    bool do_discards_deallocations() const noexcept override { return true; }
+};
+
+struct DestructionCounter {
+    static inline int destroyed = 0;
+    int value;
+    DestructionCounter(int v) : value(v) {}
+    ~DestructionCounter() { ++destroyed; }
+};
+
+TEST_F(SingleLinkedListTest, ClearSkipsDeallocationOnArena) {
+    CountingArena arena;
+    {
+        SingleLinkedList<int> list(&arena);
+        for (int i = 0; i < 100; ++i) list.push_front(i);
+        list.clear();
+        EXPECT_TRUE(list.empty());
+        for (int i = 0; i < 10; ++i) list.push_front(i);
+    }
+    EXPECT_EQ(arena.deallocations, 0u);
+
+    DestructionCounter::destroyed = 0;
+    {
+        SingleLinkedList<DestructionCounter> list(&arena);
+        for (int i = 0; i < 50; ++i) list.emplace_front(i);
+    }
+    EXPECT_EQ(DestructionCounter::destroyed, 50);
+    EXPECT_EQ(arena.deallocations, 0u);
+
+    EXPECT_TRUE(discards_deallocations(&arena));
+    std::pmr::monotonic_buffer_resource monotonic;
+    EXPECT_TRUE(discards_deallocations(&monotonic));
+    EXPECT_FALSE(discards_deallocations(resource.get()));
+}
+
+TEST_F(SingleLinkedListTest, ClearReturnsNodesInBatches) {
+    CustomMemoryResource slab_resource(nullptr, 64 * 1024);
+    slab_resource.set_retention_limit(0);
+    {
+        SingleLinkedList<std::string> list(&slab_resource);
+        for (int i = 0; i < 1000; ++i) list.push_front(std::string(40, 'x'));
+        list.clear();
+    }
+    auto stats = slab_resource.stats();
+    EXPECT_EQ(stats.deallocations, 1000u);
+    EXPECT_EQ(stats.blocks_live, 0u);
+    EXPECT_EQ(stats.bytes_from_parent, 0u);
+
+    CountingResource counting;
+    {
+        SingleLinkedList<int> list(&counting);
+        for (int i = 0; i < 100; ++i) list.push_front(i);
+    }
+    EXPECT_EQ(counting.deallocations, 100u);
+}
+
+// Копирующее присваивание с переиспользованием узлов
+TEST_F(SingleLinkedListTest, CopyAssignmentReusesNodes) {
+    std::vector<std::string> first_values = {"a", "b", "c"};
+    std::vector<std::string> second_values = {"x", "y", "z"};
+    SingleLinkedList<std::string> source(first_values.begin(), first_values.end(), resource.get());
+    SingleLinkedList<std::string> other_source(second_values.begin(), second_values.end(), resource.get());
+    SingleLinkedList<std::string> target(resource.get());
+    target = source;
+    const std::string* first_node = &target.front();
+
+    auto before = resource->stats();
+    for (int i = 0; i < 100; ++i) {
+        target = (i % 2) ? source : other_source;
+    }
+    auto after = resource->stats();
+    EXPECT_EQ(after.allocations, before.allocations);
+    EXPECT_EQ(after.deallocations, before.deallocations);
+    EXPECT_EQ(&target.front(), first_node);
+    EXPECT_EQ(to_vector(target), first_values);
+}
+
+TEST_F(SingleLinkedListTest, CopyAssignmentGrowsAndShrinks) {
+    std::vector<int> longer = {1, 2, 3, 4, 5};
+    std::vector<int> shorter = {7, 8};
+    TailList long_list(longer.begin(), longer.end(), resource.get());
+    TailList short_list(shorter.begin(), shorter.end(), resource.get());
+    TailList target(resource.get());
+
+    target = short_list;
+    target = long_list;
+    EXPECT_EQ(to_vector(target), longer);
+    EXPECT_EQ(target.back(), 5);
+    EXPECT_EQ(resource->stats().blocks_live, 12u);
+
+    target = short_list;
+    EXPECT_EQ(to_vector(target), shorter);
+    EXPECT_EQ(target.size(), 2u);
+    EXPECT_EQ(target.back(), 8);
+    EXPECT_EQ(resource->stats().blocks_live, 9u);
+    target.push_back(9);
+    EXPECT_EQ(to_vector(target), std::vector<int>({7, 8, 9}));
+
+    TailList empty(resource.get());
+    target = empty;
+    EXPECT_TRUE(target.empty());
+    target.push_back(1);
+    EXPECT_EQ(target.front(), 1);
+}
+
+TEST_F(SingleLinkedListTest, CopyAssignmentKeepsOwnAllocator) {
+    CustomMemoryResource other_resource;
+    SingleLinkedList<int> source(&other_resource);
+    source.push_front(2);
+    source.push_front(1);
+
+    SingleLinkedList<int> target(resource.get());
+    target.push_front(5);
+    target = source;
+
+    EXPECT_EQ(target.get_allocator().resource(), resource.get());
+    EXPECT_EQ(to_vector(target), std::vector<int>({1, 2}));
+    EXPECT_EQ(resource->stats().blocks_live, 2u);
+    EXPECT_EQ(other_resource.stats().blocks_live, 2u);
+}
+
+// Параллельный обход
+TEST_F(SingleLinkedListTest, PartitionCoversListOnce) {
+    std::vector<int> values(103);
+    std::iota(values.begin(), values.end(), 0);
+    SingleLinkedList<int> list(values.begin(), values.end(), resource.get());
+
+    auto partition = partition_list(list, 10);
+    ASSERT_EQ(partition.chunks(), 10u);
+    std::vector<int> seen;
+    for (size_t chunk = 0; chunk < partition.chunks(); ++chunk) {
+        auto it = partition.starts[chunk];
+        for (size_t i = 0; i < partition.counts[chunk]; ++i, ++it) seen.push_back(*it);
+    }
+    EXPECT_EQ(seen, values);
+
+    SingleLinkedList<int> small(resource.get());
+    EXPECT_EQ(partition_list(small, 4).chunks(), 0u);
+    small.push_front(1);
+    EXPECT_EQ(partition_list(small, 4).chunks(), 1u);
+}
+
+TEST_F(SingleLinkedListTest, ParallelForEachAndReduce) {
+    ConcurrentMemoryResource shared;
+    std::vector<long> values(10000);
+    std::iota(values.begin(), values.end(), 1);
+    SingleLinkedList<long> list(values.begin(), values.end(), &shared);
+
+    parallel_for_each(list, [](long& value) { value *= 3; }, 4);
+    long expected = 3 * 10000L * 10001 / 2;
+    EXPECT_EQ(std::accumulate(list.begin(), list.end(), 0L), expected);
+
+    auto partition = partition_list(list, 16);
+    for (size_t threads : {1u, 2u, 8u}) {
+        long sum = parallel_transform_reduce(partition, 5L, std::plus<>(), [](long value) { return value; }, threads);
+        EXPECT_EQ(sum, expected + 5);
+    }
+
+    std::atomic<size_t> visited{0};
+    parallel_for_each(partition, [&](const long&) { visited.fetch_add(1); });
+    EXPECT_EQ(visited.load(), values.size());
+
+    UnrolledSingleLinkedList<int> unrolled(values.begin(), values.end(), &shared);
+    EXPECT_EQ(parallel_transform_reduce(unrolled, 0L, std::plus<>(), [](int value) { return long{value}; }),
+              10000L * 10001 / 2);
+
+    SingleLinkedList<long> empty(&shared);
+    EXPECT_EQ(parallel_transform_reduce(empty, 7L, std::plus<>(), [](long value) { return value; }), 7L);
+}
+
+TEST_F(SingleLinkedListTest, ParallelForEachPropagatesException) {
+    std::vector<int> values(1000);
+    std::iota(values.begin(), values.end(), 0);
+    SingleLinkedList<int> list(values.begin(), values.end(), resource.get());
+
+    EXPECT_THROW(parallel_for_each(list, [](int value) {
+        if (value == 500) throw std::runtime_error("bad element");
+    }, 4), std::runtime_error);
+}
+
+// Уплотнение
+TEST_F(SingleLinkedListTest, CompactRelocatesNodesContiguously) {
+    CustomMemoryResource slab_resource(nullptr, 64 * 1024);
+    SingleLinkedList<long> list(&slab_resource);
+    SingleLinkedList<long> noise(&slab_resource);
+    std::mt19937 rng(3);
+
+    // Перемешивание: узлы списка занимают освободившиеся слоты вперемешку с чужими
+    for (long i = 0; i < 20000; ++i) {
+        noise.push_front(i);
+    }
+    noise.remove_if([&](long) { return rng() % 2 == 0; });
+    for (long i = 0; i < 5000; ++i) {
+        list.push_front(i);
+        if (rng() % 2) noise.push_front(i);
+    }
+    std::vector<long> expected = to_vector(list);
+
+    auto count_adjacent = [](const SingleLinkedList<long>& target) {
+        size_t adjacent = 0;
+        const long* previous = nullptr;
+        for (const long& value : target) {
+            if (previous && reinterpret_cast<const char*>(&value) - reinterpret_cast<const char*>(previous) ==
+                                static_cast<std::ptrdiff_t>(CustomMemoryResource::size_class_size(
+                                    CustomMemoryResource::size_class_index(sizeof(SingleLinkedListNode<long>),
+                                                                           alignof(SingleLinkedListNode<long>))))) {
+                ++adjacent;
+            }
+            previous = &value;
+        }
+        return adjacent;
+    };
+    size_t before = count_adjacent(list);
+    size_t live_before = slab_resource.stats().blocks_live;
+
+    list.compact();
+
+    EXPECT_EQ(to_vector(list), expected);
+    EXPECT_GT(count_adjacent(list), before);
+    EXPECT_GE(count_adjacent(list), list.size() * 9 / 10);
+    EXPECT_EQ(slab_resource.stats().blocks_live, live_before);
+
+    noise.clear();
+    slab_resource.trim();
+    size_t node_bytes = list.size() * CustomMemoryResource::size_class_size(
+        CustomMemoryResource::size_class_index(sizeof(SingleLinkedListNode<long>), alignof(SingleLinkedListNode<long>)));
+    EXPECT_LE(slab_resource.stats().bytes_from_parent, node_bytes + 2 * 64 * 1024);
+}
+
+TEST_F(SingleLinkedListTest, CompactKeepsListOnThrowingCopy) {
+    SingleLinkedList<ThrowingCopy> list(resource.get());
+    for (int i = 0; i < 10; ++i) list.emplace_front(i);
+    const ThrowingCopy* first = &list.front();
+
+    ThrowingCopy::until_throw = 5;
+    EXPECT_THROW(list.compact(), std::runtime_error);
+    EXPECT_EQ(&list.front(), first);
+    EXPECT_EQ(list.size(), 10u);
+    EXPECT_EQ(resource->stats().blocks_live, 10u);
+
+    ThrowingCopy::until_throw = 0;
+    list.compact();
+    EXPECT_EQ(list.front().value, 9);
+    EXPECT_EQ(resource->stats().blocks_live, 10u);
+
+    TailList tail_list(resource.get());
+    tail_list.compact();
+    tail_list.push_back(1);
+    tail_list.push_back(2);
+    tail_list.compact();
+    tail_list.push_back(3);
+    EXPECT_EQ(to_vector(tail_list), std::vector<int>({1, 2, 3}));
+}
+
+// Список со встроенными узлами
+TEST_F(SingleLinkedListTest, SmallListAvoidsUpstreamWhileShort) {
+    CountingResource upstream;
+    {
+        SmallSingleLinkedList<int, 4> list(&upstream);
+        for (int round = 0; round < 100; ++round) {
+            for (int i = 0; i < 4; ++i) list.push_front(i);
+            EXPECT_EQ(list.inline_available(), 0u);
+            list.clear();
+        }
+        EXPECT_EQ(upstream.allocations, 0u);
+
+        for (int i = 0; i < 6; ++i) list.push_front(i);
+        EXPECT_EQ(upstream.allocations, 2u);
+        EXPECT_EQ(to_vector(list), std::vector<int>({5, 4, 3, 2, 1, 0}));
+        list.sort();
+        EXPECT_EQ(list.front(), 0);
+        list.pop_front();
+        list.pop_front();
+    }
+    EXPECT_EQ(upstream.deallocations, upstream.allocations);
+}
+
+TEST_F(SingleLinkedListTest, SmallListCopyAndMove) {
+    CountingResource upstream;
+    std::vector<std::string> values = {"one", "two", "three"};
+    SmallSingleLinkedList<std::string, 4, TailTrackingPolicy> list(values.begin(), values.end(), &upstream);
+    EXPECT_EQ(list.back(), "three");
+
+    auto copy = list;
+    EXPECT_EQ(to_vector(copy), values);
+    EXPECT_EQ(copy.upstream_resource(), &upstream);
+    EXPECT_NE(copy.get_allocator(), list.get_allocator());
+    copy.push_back("four");
+    copy.push_back("five");
+    EXPECT_EQ(list.size(), 3u);
+
+    SmallSingleLinkedList<std::string, 4, TailTrackingPolicy> moved(std::move(copy));
+    EXPECT_TRUE(copy.empty());
+    EXPECT_EQ(moved.size(), 5u);
+    EXPECT_EQ(moved.back(), "five");
+
+    list = moved;
+    EXPECT_EQ(to_vector(list), to_vector(moved));
+    moved = std::move(list);
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(moved.front(), "one");
+
+    list.push_back("x");
+    swap(list, moved);
+    EXPECT_EQ(to_vector(list), std::vector<std::string>({"one", "two", "three", "four", "five"}));
+    EXPECT_EQ(to_vector(moved), std::vector<std::string>({"x"}));
+    EXPECT_EQ(list.back(), "five");
+}
+
+TEST_F(SingleLinkedListTest, SmallListAssignStaysInline) {
+    CountingResource upstream;
+    SmallSingleLinkedList<int, 4> list(&upstream);
+    std::vector<int> values = {1, 2, 3, 4};
+    list.assign(values.begin(), values.end());
+    list.assign(values.rbegin(), values.rend());
+    EXPECT_EQ(to_vector(list), std::vector<int>({4, 3, 2, 1}));
+    list.assign(4, 7);
+    EXPECT_EQ(to_vector(list), std::vector<int>(4, 7));
+    EXPECT_EQ(upstream.allocations, 0u);
+}
+
+// Временный файл, удаляемый при выходе из теста
+struct TempFile {
+    std::string path;
+
+    explicit TempFile(const char* name)
+        : path((std::filesystem::temp_directory_path() /
+                (std::string(name) + "_" + std::to_string(::getpid()))).string()) {
+        std::filesystem::remove(path);
+    }
+
+    ~TempFile() { std::filesystem::remove(path); }
+};
+
+TEST_F(SingleLinkedListTest, PersistentListSurvivesReopen) {
+    TempFile file("persistent_list");
+    {
+        MappedFileMemoryResource mapped(file.path, 1 << 20);
+        EXPECT_FALSE(mapped.reopened());
+        PersistentSingleLinkedList<int> list(mapped, 0);
+        std::vector<int> values = {1, 2, 3, 4, 5};
+        list.assign(values.begin(), values.end());
+        list.pop_front();
+        list.erase_after(list.begin());
+        mapped.flush();
+    }
+    {
+        MappedFileMemoryResource mapped(file.path, 0);
+        EXPECT_TRUE(mapped.reopened());
+        PersistentSingleLinkedList<int> list(mapped, 0);
+        EXPECT_EQ(std::vector<int>(list.begin(), list.end()), std::vector<int>({2, 4, 5}));
+        EXPECT_EQ(list.size(), 3u);
+
+        // Освобождённые до закрытия узлы переиспользуются, файл не растёт
+        size_t used = mapped.used();
+        list.push_front(1);
+        list.insert_after(list.begin(), 3);
+        EXPECT_EQ(mapped.used(), used);
+        EXPECT_EQ(std::vector<int>(list.begin(), list.end()), std::vector<int>({1, 3, 2, 4, 5}));
+    }
+}
+
+TEST_F(SingleLinkedListTest, PersistentListRootsAreIndependent) {
+    TempFile file("persistent_roots");
+    MappedFileMemoryResource mapped(file.path, 1 << 16);
+    PersistentSingleLinkedList<int> first(mapped, 0);
+    PersistentSingleLinkedList<double> second(mapped, 1);
+    first.push_front(1);
+    second.push_front(2.5);
+    EXPECT_EQ(first.front(), 1);
+    EXPECT_EQ(second.front(), 2.5);
+    EXPECT_THROW((PersistentSingleLinkedList<double>(mapped, 0)), std::runtime_error);
+    EXPECT_THROW(mapped.root(MappedFileMemoryResource::kRootSlots), std::out_of_range);
+}
+
+TEST_F(SingleLinkedListTest, MappedResourceLimitsAndValidation) {
+    TempFile file("mapped_limits");
+    {
+        MappedFileMemoryResource mapped(file.path, 1 << 15);
+        // Большие блоки возвращаются и выдаются повторно
+        void* large = mapped.allocate(6000, 16);
+        mapped.deallocate(large, 6000, 16);
+        EXPECT_EQ(mapped.allocate(5000, 16), large);
+        EXPECT_THROW(static_cast<void>(mapped.allocate(1 << 20)), std::bad_alloc);
+
+        PersistentSingleLinkedList<int> list(mapped, 0);
+        EXPECT_THROW(for (;;) list.push_front(0), std::bad_alloc);
+        size_t full = list.size();
+        list.pop_front();
+        list.push_front(1);
+        EXPECT_EQ(list.size(), full);
+    }
+
+    std::filesystem::remove(file.path);
+    { std::ofstream(file.path) << "definitely not a list file, but long enough to hold a header...."
+                                  "................................................................"
+                                  "................................................................"
+                                  "................................................................"; }
+    EXPECT_THROW(MappedFileMemoryResource(file.path, 8192), std::runtime_error);
+    EXPECT_THROW(MappedFileMemoryResource("/nonexistent_dir/list.bin", 8192), std::system_error);
+}
+
+TEST_F(SingleLinkedListTest, BinarySaveLoadTriviallyCopyable) {
+    SingleLinkedList<int> list(resource.get());
+    std::vector<int> values(40000);
+    std::iota(values.begin(), values.end(), -100);
+    list.assign(values.begin(), values.end());
+
+    std::stringstream stream;
+    list.save(stream);
+    EXPECT_EQ(stream.str().size(), 24 + values.size() * sizeof(int));
+
+    TailList loaded(resource.get());
+    loaded.push_back(7);
+    loaded.load(stream);
+    EXPECT_EQ(to_vector(loaded), values);
+    EXPECT_EQ(loaded.back(), values.back());
+
+    std::stringstream empty_stream;
+    SingleLinkedList<int>(resource.get()).save(empty_stream);
+    loaded.load(empty_stream);
+    EXPECT_TRUE(loaded.empty());
+}
+
+// Пользовательский формат элемента
+struct SerializedRecord {
+    int id;
+    std::string name;
+
+    bool operator==(const SerializedRecord& other) const { return id == other.id && name == other.name; }
+};
+
+template <>
+struct BinarySerializer<SerializedRecord> {
+    static void write(std::ostream& os, const SerializedRecord& record) {
+        binary_io::write_value(os, record.id);
+        BinarySerializer<std::string>::write(os, record.name);
+    }
+
+    static SerializedRecord read(std::istream& is) {
+        int id = binary_io::read_value<int>(is);
+        return SerializedRecord{id, BinarySerializer<std::string>::read(is)};
+    }
+};
+
+TEST_F(SingleLinkedListTest, BinarySaveLoadCustomSerializer) {
+    SingleLinkedList<SerializedRecord> list(resource.get());
+    list.push_front({2, std::string(100, 'b')});
+    list.push_front({1, "a"});
+    list.push_front({0, ""});
+
+    std::stringstream stream;
+    list.save(stream);
+    SingleLinkedList<SerializedRecord> loaded(resource.get());
+    loaded.load(stream);
+    EXPECT_EQ(to_vector(loaded), to_vector(list));
+
+    SingleLinkedList<std::string> strings(resource.get());
+    strings.push_front("world");
+    strings.push_front("hello");
+    std::stringstream string_stream;
+    strings.save(string_stream);
+    SingleLinkedList<std::string> loaded_strings(resource.get());
+    loaded_strings.load(string_stream);
+    EXPECT_EQ(to_vector(loaded_strings), std::vector<std::string>({"hello", "world"}));
+}
+
+TEST_F(SingleLinkedListTest, BinaryLoadErrorsKeepList) {
+    SingleLinkedList<int> list(resource.get());
+    for (int i = 0; i < 1000; ++i) list.push_front(i);
+    std::stringstream saved;
+    list.save(saved);
+    std::string data = saved.str();
+
+    SingleLinkedList<int> target(resource.get());
+    target.push_front(42);
+
+    std::stringstream truncated(data.substr(0, data.size() - 1));
+    EXPECT_THROW(target.load(truncated), std::runtime_error);
+    std::stringstream garbage(std::string(64, 'x'));
+    EXPECT_THROW(target.load(garbage), std::runtime_error);
+    EXPECT_EQ(to_vector(target), std::vector<int>({42}));
+
+    std::stringstream wrong_type(data);
+    SingleLinkedList<double> doubles(resource.get());
+    EXPECT_THROW(doubles.load(wrong_type), std::runtime_error);
+    std::stringstream wrong_format(data);
+    SingleLinkedList<std::string> strings(resource.get());
+    EXPECT_THROW(strings.load(wrong_format), std::runtime_error);
+}
+
+TEST_F(SingleLinkedListTest, BinaryLoadRejectsForgedStringLength) {
+    SingleLinkedList<std::string> source(resource.get());
+    source.push_front("payload");
+    std::stringstream saved;
+    source.save(saved);
+    std::string data = saved.str();
+
+    uint64_t length = 7;
+    std::string length_bytes(reinterpret_cast<const char*>(&length), sizeof(length));
+    size_t at = data.find(length_bytes + "payload");
+    ASSERT_NE(at, std::string::npos);
+
+    SingleLinkedList<std::string> target(resource.get());
+    target.push_front("kept");
+    for (uint64_t forged : {uint64_t{1} << 40, ~uint64_t{0}}) {
+        std::string bad = data;
+        bad.replace(at, sizeof(forged), reinterpret_cast<const char*>(&forged), sizeof(forged));
+        std::stringstream stream(bad);
+        EXPECT_THROW(target.load(stream), std::runtime_error);
+        EXPECT_EQ(to_vector(target), std::vector<std::string>({"kept"}));
+    }
+}
+
+TEST_F(SingleLinkedListTest, SortedListMatchesMultiset) {
+    SortedSingleLinkedList<int> list(resource.get());
+    std::multiset<int> expected;
+    std::mt19937 rng(23);
+    std::uniform_int_distribution<int> value(0, 500);
+    for (int step = 0; step < 20000; ++step) {
+        int v = value(rng);
+        if (rng() % 3 != 0) {
+            EXPECT_EQ(*list.insert(v), v);
+            expected.insert(v);
+        } else {
+            auto found = expected.find(v);
+            EXPECT_EQ(list.erase(v), found != expected.end());
+            if (found != expected.end()) expected.erase(found);
+        }
+        if (step % 1000 == 0) {
+            ASSERT_EQ(std::vector<int>(list.begin(), list.end()),
+                      std::vector<int>(expected.begin(), expected.end()));
+        }
+    }
+    EXPECT_EQ(std::vector<int>(list.begin(), list.end()), std::vector<int>(expected.begin(), expected.end()));
+    EXPECT_EQ(list.size(), expected.size());
+    EXPECT_LE(list.index_size(), list.size() / (SortedSingleLinkedList<int>::kStride / 2) + 2);
+
+    for (int v = -1; v <= 501; ++v) {
+        auto it = list.lower_bound(v);
+        auto reference = expected.lower_bound(v);
+        if (reference == expected.end()) {
+            EXPECT_TRUE(it == list.end());
+        } else {
+            ASSERT_TRUE(it != list.end());
+            EXPECT_EQ(*it, *reference);
+        }
+        EXPECT_EQ(list.contains(v), expected.count(v) > 0);
+    }
+
+    size_t count = expected.count(250);
+    EXPECT_EQ(list.erase_all(250), count);
+    EXPECT_FALSE(list.contains(250));
+    expected.erase(250);
+    while (!list.empty()) {
+        EXPECT_EQ(list.front(), *expected.begin());
+        list.pop_front();
+        expected.erase(expected.begin());
+    }
+    EXPECT_EQ(list.index_size(), 0u);
+}
+
+// Прозрачное сравнение записей по ключу
+struct KeyedRecord {
+    int id;
+    std::string name;
+};
+
+struct ById {
+    using is_transparent = void;
+    bool operator()(const KeyedRecord& a, const KeyedRecord& b) const { return a.id < b.id; }
+    bool operator()(const KeyedRecord& a, int id) const { return a.id < id; }
+    bool operator()(int id, const KeyedRecord& a) const { return id < a.id; }
+};
+
+TEST_F(SingleLinkedListTest, SortedListByKeyCopyAndMove) {
+    std::vector<KeyedRecord> records;
+    for (int i = 0; i < 300; ++i) records.push_back({(i * 37) % 300, "r" + std::to_string(i)});
+    SortedSingleLinkedList<KeyedRecord, ById> list(records.begin(), records.end(), resource.get());
+    EXPECT_EQ(list.size(), 300u);
+    EXPECT_GT(list.index_size(), 1u);
+    EXPECT_EQ(list.find(123)->id, 123);
+    EXPECT_TRUE(list.find(300) == list.end());
+    list.insert({150, "duplicate"});
+    EXPECT_EQ(std::next(list.find(150))->name, "duplicate");
+
+    SortedSingleLinkedList<KeyedRecord, ById> copy(list);
+    EXPECT_TRUE(copy.erase(0));
+    EXPECT_EQ(copy.front().id, 1);
+    EXPECT_EQ(list.front().id, 0);
+
+    SortedSingleLinkedList<KeyedRecord, ById> moved(std::move(copy));
+    EXPECT_TRUE(copy.empty());
+    EXPECT_EQ(moved.find(299)->id, 299);
+
+    SortedSingleLinkedList<KeyedRecord, ById> other;
+    other = std::move(moved);
+    EXPECT_EQ(other.size(), 300u);
+    EXPECT_EQ(other.find(7)->id, 7);
+    other = list;
+    EXPECT_EQ(other.find(0)->id, 0);
+    EXPECT_EQ(other.size(), 301u);
+}
+
+TEST_F(SingleLinkedListTest, HashMapMatchesUnorderedMap) {
+    ChainedHashMap<std::string, int> map(resource.get());
+    std::unordered_map<std::string, int> expected;
+    std::mt19937 rng(24);
+    for (int step = 0; step < 20000; ++step) {
+        std::string key = "person-" + std::to_string(rng() % 3000);
+        switch (rng() % 4) {
+        case 0:
+            EXPECT_EQ(map.erase(key), expected.erase(key) > 0);
+            break;
+        case 1:
+            map[key] += step;
+            expected[key] += step;
+            break;
+        default:
+            EXPECT_EQ(map.insert(key, step), expected.emplace(key, step).second);
+            break;
+        }
+    }
+    EXPECT_EQ(map.size(), expected.size());
+    for (const auto& [key, value] : expected) {
+        ASSERT_NE(map.find(key), nullptr);
+        EXPECT_EQ(*map.find(key), value);
+    }
+    EXPECT_FALSE(map.contains("nobody"));
+    EXPECT_THROW(map.at("nobody"), std::out_of_range);
+    EXPECT_LE(map.load_factor(), map.max_load_factor());
+
+    size_t visited = 0;
+    map.for_each([&](const std::string& key, int value) {
+        EXPECT_EQ(expected.at(key), value);
+        ++visited;
+    });
+    EXPECT_EQ(visited, expected.size());
+}
+
+TEST_F(SingleLinkedListTest, HashMapRehashesIncrementally) {
+    ChainedHashMap<int, int> map(resource.get(), 8);
+    for (int i = 0; i < 64; ++i) map.insert(i, i);
+    size_t buckets = map.bucket_count();
+
+    // Первая вставка сверх предела только начинает перенос; дальше каждая изменяющая
+    // операция переносит по kRehashStep = 4 корзины
+    while (map.bucket_count() == buckets) map.insert(static_cast<int>(map.size()), 0);
+    EXPECT_TRUE(map.rehash_in_progress());
+    for (int i = 0; i < 64; ++i) EXPECT_EQ(*map.find(i), i);
+    EXPECT_TRUE(map.erase(3));
+    EXPECT_FALSE(map.contains(3));
+
+    size_t steps = 0;
+    while (map.rehash_in_progress()) {
+        map.insert(1000 + static_cast<int>(steps), 0);
+        ++steps;
+    }
+    EXPECT_EQ(steps, (buckets - 4) / 4);
+    EXPECT_EQ(*map.find(63), 63);
+
+    map.reserve(10000);
+    EXPECT_FALSE(map.rehash_in_progress());
+    EXPECT_GE(map.bucket_count(), 10000u);
+    EXPECT_THROW(map.max_load_factor(0.0f), std::invalid_argument);
+}
+
+TEST_F(SingleLinkedListTest, HashMapRehashFinishesBeforeNextGrowth) {
+    // При низком max_load_factor следующий рост наступает через малую долю корзин
+    // вставок; перенос всё равно должен идти ровными шагами и закончиться до него
+    ChainedHashMap<int, int> map(resource.get());
+    map.max_load_factor(0.125f);
+    size_t growths = 0;
+    size_t max_moved = 0;
+    for (int i = 0; map.bucket_count() < 4096; ++i) {
+        size_t buckets = map.bucket_count();
+        size_t pending = map.rehash_pending();
+        map.insert(i, i);
+        if (map.bucket_count() != buckets) {
+            // Вставка сначала переносит свой шаг; рост допустим, только если им перенос и закончился
+            EXPECT_LE(pending, 16u) << "growth flushed an unfinished rehash at " << i;
+            ++growths;
+        } else {
+            max_moved = std::max(max_moved, pending - map.rehash_pending());
+        }
+    }
+    EXPECT_GE(growths, 8u);
+    EXPECT_LE(max_moved, 16u);
+    for (int i = 0; i < static_cast<int>(map.size()); ++i) ASSERT_EQ(*map.find(i), i);
+
+    // Уменьшенный во время переноса предел не вызывает нового роста до конца переноса
+    while (!map.rehash_in_progress()) map.insert(static_cast<int>(map.size()), 0);
+    size_t buckets = map.bucket_count();
+    map.max_load_factor(0.01f);
+    size_t pending = 0;
+    size_t deferred = 0;
+    for (;;) {
+        pending = map.rehash_pending();
+        map.insert(static_cast<int>(map.size()), 0);
+        if (map.bucket_count() != buckets) break;
+        EXPECT_LE(pending - map.rehash_pending(), 16u);
+        ++deferred;
+    }
+    EXPECT_GT(deferred, 0u);
+    EXPECT_LE(pending, 16u);
+    EXPECT_EQ(map.bucket_count(), buckets * 2);
+}
+
+TEST_F(SingleLinkedListTest, HashMapSharesResourceAndMoves) {
+    CountingResource shared;
+    {
+        ChainedHashMap<std::string, std::string> map(&shared);
+        map.insert("alice", "a");
+        map.insert("bob", "b");
+        size_t allocations = shared.allocations;
+        EXPECT_GE(allocations, 3u);
+
+        ChainedHashMap<std::string, std::string> copy(map);
+        EXPECT_EQ(copy.get_allocator().resource(), &shared);
+        EXPECT_EQ(copy.at("bob"), "b");
+
+        ChainedHashMap<std::string, std::string> moved(std::move(map));
+        EXPECT_TRUE(map.empty());
+        EXPECT_EQ(moved.at("alice"), "a");
+        map.insert("carol", "c");
+
+        ChainedHashMap<std::string, std::string> other(resource.get());
+        other = std::move(moved);
+        EXPECT_TRUE(moved.empty());
+        EXPECT_EQ(other.size(), 2u);
+        EXPECT_EQ(other.get_allocator().resource(), resource.get());
+        other = copy;
+        EXPECT_EQ(other.at("alice"), "a");
+        copy = std::move(map);
+        EXPECT_EQ(copy.size(), 1u);
+        EXPECT_EQ(copy.at("carol"), "c");
+    }
+    EXPECT_EQ(shared.allocations, shared.deallocations);
+}
+
+TEST_F(SingleLinkedListTest, CompactListBasicOperations) {
+    static_assert(sizeof(CompactNode<int>) == 8, "int node must be 8 bytes");
+    CompactSingleLinkedList<int, CustomMemoryResource> list(resource.get());
+    std::forward_list<int> expected;
+    for (int i = 0; i < 3000; ++i) {
+        list.push_front(i);
+        expected.push_front(i);
+    }
+    EXPECT_EQ(list.front(), 2999);
+    list.pop_front();
+    expected.pop_front();
+
+    auto it = list.begin();
+    auto expected_it = expected.begin();
+    for (int i = 0; i < 100; ++i, ++it, ++expected_it) {}
+    list.erase_after(it);
+    expected.erase_after(expected_it);
+    list.insert_after(it, -1);
+    expected.insert_after(expected_it, -1);
+    list.emplace_after(list.before_begin(), -2);
+    expected.emplace_after(expected.before_begin(), -2);
+    list.reverse();
+    expected.reverse();
+
+    EXPECT_EQ(std::vector<int>(list.begin(), list.end()), std::vector<int>(expected.begin(), expected.end()));
+    EXPECT_EQ(list.size(), static_cast<size_t>(std::distance(expected.begin(), expected.end())));
+    EXPECT_THROW(list.erase_after(list.before_begin()), std::logic_error);
+
+    CompactSingleLinkedList<int, CustomMemoryResource> copy(list);
+    CompactSingleLinkedList<int, CustomMemoryResource> moved(std::move(list));
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(std::vector<int>(copy.begin(), copy.end()), std::vector<int>(moved.begin(), moved.end()));
+    list = copy;
+    EXPECT_EQ(list.size(), copy.size());
+    moved = std::move(list);
+    EXPECT_EQ(moved.size(), copy.size());
+    EXPECT_TRUE(list.empty());
+    EXPECT_THROW(list.pop_front(), std::logic_error);
+}
+
+TEST_F(SingleLinkedListTest, CompactListPoolReuse) {
+    CountingResource parent;
+    CompactSingleLinkedList<int, CountingResource> list(&parent);
+    for (int i = 0; i < 2048; ++i) list.push_front(i);
+    size_t allocations = parent.allocations;
+    EXPECT_LE(allocations, 4u);
+
+    // clear и pop_front возвращают узлы пулу, ресурс при повторном заполнении не нужен
+    list.clear();
+    for (int i = 0; i < 2048; ++i) list.push_front(i);
+    for (int i = 0; i < 1000; ++i) list.pop_front();
+    for (int i = 0; i < 1000; ++i) list.push_front(i);
+    EXPECT_EQ(parent.allocations, allocations);
+    EXPECT_EQ(list.size(), 2048u);
+}
+
+TEST_F(SingleLinkedListTest, AutoListSelectsNodeLayout) {
+    static_assert(use_compact_nodes<int>, "int uses compact nodes");
+    static_assert(!use_compact_nodes<std::string>, "std::string keeps pointer nodes");
+    static_assert(!use_compact_nodes<long double>, "large values gain nothing from index links");
+    static_assert(std::is_same_v<AutoSingleLinkedList<int>, CompactSingleLinkedList<int>>);
+    static_assert(std::is_same_v<AutoSingleLinkedList<std::string>, SingleLinkedList<std::string>>);
+
+    AutoSingleLinkedList<int> ints(resource.get());
+    AutoSingleLinkedList<std::string> strings(resource.get());
+    ints.push_front(1);
+    strings.push_front("one");
+    EXPECT_EQ(ints.front(), 1);
+    EXPECT_EQ(strings.front(), "one");
+}
+
+TEST_F(SingleLinkedListTest, FastResourceReusesBlocksWithoutChecks) {
+    static_assert(CustomMemoryResource::kChecked && !FastMemoryResource::kChecked, "policies differ");
+    CountingResource parent;
+    {
+        FastMemoryResource fast(&parent);
+        EXPECT_TRUE(fast.slab_mode());
+
+        void* first = fast.allocate(24, 8);
+        void* second = fast.allocate(24, 8);
+        EXPECT_EQ(static_cast<char*>(second) - static_cast<char*>(first), 32);
+        fast.deallocate(first, 24, 8);
+        EXPECT_EQ(fast.allocate(24, 8), first);
+        fast.deallocate(first, 24, 8);
+        fast.deallocate(second, 24, 8);
+
+        // Большие блоки по-прежнему переиспользуются через реестр
+        void* large = fast.allocate(10000, 16);
+        fast.deallocate(large, 10000, 16);
+        EXPECT_EQ(fast.allocate(9000, 16), large);
+        EXPECT_EQ(fast.stats().blocks_from_parent, 2u);
+
+        TailList list(&fast);
+        for (int i = 0; i < 5000; ++i) list.push_back(i);
+        std::vector<int> values(2000, 7);
+        list.assign(values.begin(), values.end());
+        list.compact();
+        EXPECT_EQ(to_vector(list), values);
+    }
+    EXPECT_EQ(parent.allocations, parent.deallocations);
+}
+
+TEST_F(SingleLinkedListTest, MoveAssignAcrossAllocatorsMovesElements) {
+    CountingResource source_resource;
+    CountingResource target_resource;
+    SingleLinkedList<ConstructionCounter, TailTrackingPolicy> source(&source_resource);
+    for (int i = 0; i < 200; ++i) source.emplace_back(i, "a name that does not fit into the small buffer");
+    SingleLinkedList<ConstructionCounter, TailTrackingPolicy> target(&target_resource);
+    target.emplace_back(-1, "old");
+
+    ConstructionCounter::reset();
+    target = std::move(source);
+    EXPECT_EQ(ConstructionCounter::copies, 0);
+    EXPECT_EQ(ConstructionCounter::moves, 200);
+    EXPECT_TRUE(source.empty());
+    EXPECT_EQ(source_resource.allocations, source_resource.deallocations);
+    EXPECT_EQ(target.size(), 200u);
+    EXPECT_EQ(target.front().id, 0);
+    EXPECT_EQ(target.back().id, 199);
+    EXPECT_EQ(target.back().name, "a name that does not fit into the small buffer");
+    EXPECT_EQ(target.get_allocator().resource(), &target_resource);
+
+    source.emplace_back(7, "reused");
+    EXPECT_EQ(source.back().id, 7);
+}
+
+TEST_F(SingleLinkedListTest, MoveAssignAcrossAllocatorsKeepsElementsOnThrow) {
+    CustomMemoryResource other_resource;
+    SingleLinkedList<ThrowingCopy> source(&other_resource);
+    for (int i = 0; i < 100; ++i) source.emplace_front(i);
+    SingleLinkedList<ThrowingCopy> target(resource.get());
+
+    ThrowingCopy::until_throw = 71;
+    EXPECT_THROW(target = std::move(source), std::runtime_error);
+    EXPECT_EQ(target.size(), 70u);
+    EXPECT_EQ(source.size(), 30u);
+    EXPECT_EQ(target.front().value, 99);
+    EXPECT_EQ(source.front().value, 29);
+    EXPECT_EQ(static_cast<size_t>(std::distance(source.begin(), source.end())), 30u);
+}
+
+TEST_F(SingleLinkedListTest, AdoptTakesAllocatorAndNodes) {
+    CountingResource source_resource;
+    SingleLinkedList<std::string, TailTrackingPolicy> source(&source_resource);
+    source.push_back("first");
+    source.push_back("second");
+    SingleLinkedList<std::string, TailTrackingPolicy> target(resource.get());
+    target.push_back("old");
+
+    size_t allocations = source_resource.allocations;
+    target.adopt(std::move(source));
+    EXPECT_EQ(source_resource.allocations, allocations);
+    EXPECT_EQ(target.get_allocator().resource(), &source_resource);
+    EXPECT_EQ(source.get_allocator().resource(), &source_resource);
+    EXPECT_TRUE(source.empty());
+    EXPECT_EQ(to_vector(target), std::vector<std::string>({"first", "second"}));
+    target.push_back("third");
+    EXPECT_EQ(target.back(), "third");
+    EXPECT_EQ(source_resource.allocations, allocations + 1);
+}
+
+// Тесты для RcuSingleLinkedList
+TEST_F(SingleLinkedListTest, RcuListDefersReclaimWhileReading) {
+    CountingResource counting;
+    RcuSingleLinkedList<std::string> list(&counting);
+    list.push_front("second entry that does not fit into the small buffer");
+    list.push_front("first entry that does not fit into the small buffer");
+
+    {
+        auto guard = list.read();
+        auto it = guard.begin();
+        list.pop_front();
+        size_t freed_before = counting.deallocations;
+        EXPECT_EQ(list.reclaim(), 0u);
+        EXPECT_EQ(counting.deallocations, freed_before);
+        EXPECT_EQ(*it, "first entry that does not fit into the small buffer");
+        ++it;
+        EXPECT_EQ(*it, "second entry that does not fit into the small buffer");
+
+        std::vector<std::string> replacement{"a", "b", "c"};
+        list.assign(replacement.begin(), replacement.end());
+        EXPECT_EQ(*it, "second entry that does not fit into the small buffer");
+        EXPECT_EQ(std::vector<std::string>(guard.begin(), guard.end()), replacement);
+        EXPECT_EQ(list.retired_count(), 2u);
+    }
+
+    EXPECT_EQ(list.reclaim(), 2u);
+    EXPECT_EQ(list.retired_count(), 0u);
+    EXPECT_EQ(list.size(), 3u);
+    EXPECT_THROW({ RcuSingleLinkedList<int> empty_list; empty_list.pop_front(); }, std::logic_error);
+}
+
+TEST_F(SingleLinkedListTest, RcuListWriterOperations) {
+    RcuSingleLinkedList<int> list(resource.get());
+    std::vector<int> values{1, 2, 3, 4, 5, 6};
+    list.assign(values.begin(), values.end());
+
+    EXPECT_TRUE(list.replace_first([](int v) { return v == 3; }, 33));
+    EXPECT_FALSE(list.replace_first([](int v) { return v == 100; }, 0));
+    EXPECT_EQ(list.remove_if([](int v) { return v % 2 == 0; }), 3u);
+    {
+        auto guard = list.read();
+        EXPECT_EQ(std::vector<int>(guard.begin(), guard.end()), std::vector<int>({1, 33, 5}));
+    }
+    EXPECT_EQ(list.size(), 3u);
+
+    list.clear();
+    EXPECT_TRUE(list.empty());
+    EXPECT_TRUE(list.read().empty());
+    list.synchronize();
+    EXPECT_EQ(list.retired_count(), 0u);
+}
+
+TEST_F(SingleLinkedListTest, RcuListConcurrentReadersAndWriter) {
+    struct Entry {
+        int key;
+        std::string value;
+    };
+    constexpr int kEntries = 32;
+    RcuSingleLinkedList<Entry> list(resource.get());
+    for (int key = kEntries - 1; key >= 0; --key) {
+        list.emplace_front(Entry{key, "value " + std::to_string(key) + " generation 0"});
+    }
+
+    std::atomic<bool> stop{false};
+    std::atomic<int> failures{0};
+    std::atomic<size_t> snapshots{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 3; ++t) {
+        readers.emplace_back([&] {
+            while (!stop.load()) {
+                auto guard = list.read();
+                int expected_key = 0;
+                for (const Entry& entry : guard) {
+                    std::string prefix = "value " + std::to_string(entry.key) + " generation ";
+                    if (entry.key != expected_key++ || entry.value.compare(0, prefix.size(), prefix) != 0) {
+                        failures.fetch_add(1);
+                    }
+                }
+                if (expected_key != kEntries) failures.fetch_add(1);
+                snapshots.fetch_add(1);
+            }
+        });
+    }
+
+    for (int generation = 1; generation <= 2000; ++generation) {
+        int key = generation % kEntries;
+        list.replace_first([key](const Entry& entry) { return entry.key == key; },
+                           Entry{key, "value " + std::to_string(key) + " generation " + std::to_string(generation)});
+        if (generation % 100 == 0) std::this_thread::yield();
+    }
+    while (snapshots.load() < 10) std::this_thread::yield();
+    stop.store(true);
+    for (auto& reader : readers) reader.join();
+
+    list.synchronize();
+    EXPECT_EQ(failures.load(), 0);
+    EXPECT_EQ(list.retired_count(), 0u);
+    EXPECT_EQ(list.size(), static_cast<size_t>(kEntries));
+}
+
+// Тесты для трассировки задержек
+TEST_F(SingleLinkedListTest, LatencyHistogramPercentiles) {
+    list_trace::LatencyHistogram histogram;
+    EXPECT_EQ(histogram.percentile(0.99), 0u);
+    for (int i = 0; i < 98; ++i) histogram.record(100);
+    histogram.record(5000);
+    histogram.record(70000);
+
+    EXPECT_EQ(histogram.count(), 100u);
+    EXPECT_EQ(histogram.max(), 70000u);
+    EXPECT_EQ(histogram.bucket_count(7), 98u);  // 100 в [64, 128)
+    EXPECT_EQ(histogram.percentile(0.5), 127u);
+    EXPECT_EQ(histogram.percentile(0.99), 8191u);
+    EXPECT_EQ(histogram.percentile(1.0), 70000u);
+    EXPECT_DOUBLE_EQ(histogram.mean(), (98.0 * 100 + 5000 + 70000) / 100);
+
+    {
+        list_trace::ScopedTimer timer(histogram);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(histogram.count(), 101u);
+    EXPECT_GE(histogram.max(), 1000000u);
+
+    histogram.reset();
+    EXPECT_EQ(histogram.count(), 0u);
+    EXPECT_EQ(histogram.max(), 0u);
+}
+
+TEST_F(SingleLinkedListTest, TracingHooksRecordListAndResourceOperations) {
+    list_trace::reset_all();
+    {
+        SingleLinkedList<int> list(resource.get());
+        for (int i = 0; i < 10; ++i) list.push_front(i);
+        list.pop_front();
+    }
+    std::ostringstream report;
+    list_trace::report(report);
+    EXPECT_EQ(report.str().rfind("operation count", 0), 0u);
+#ifdef SLL_ENABLE_TRACING
+    EXPECT_EQ(list_trace::histogram(list_trace::Event::ListCreateNode).count(), 10u);
+    EXPECT_GE(list_trace::histogram(list_trace::Event::ResourceAllocate).count(), 10u);
+    EXPECT_GE(list_trace::histogram(list_trace::Event::ParentAllocate).count(), 1u);
+    EXPECT_NE(report.str().find("list_create_node 10 "), std::string::npos);
+#else
+    EXPECT_EQ(list_trace::histogram(list_trace::Event::ListCreateNode).count(), 0u);
+    EXPECT_EQ(list_trace::histogram(list_trace::Event::ResourceAllocate).count(), 0u);
+#endif
+}
+
+TEST_F(SingleLinkedListTest, CompactListChunkTableGrowsGeometrically) {
+    CountingResource counting;
+    constexpr size_t kChunks = 256;
+    {
+        CompactSingleLinkedList<int> list(&counting);
+        for (size_t i = 0; i < kChunks * IndexNodePool<CompactNode<int>, std::pmr::memory_resource>::kChunkNodes; ++i) {
+            list.push_front(static_cast<int>(i));
+        }
+        // Блоки узлов плюс log2(kChunks) + 1 перевыделений массива блоков
+        EXPECT_LE(counting.allocations, kChunks + 9);
+    }
+    EXPECT_EQ(counting.allocations, counting.deallocations);
+}
+
+TEST_F(SingleLinkedListTest, HashMapAssignmentTakesHasher) {
+    struct SeededHash {
+        size_t seed;
+        size_t operator()(int key) const { return (static_cast<size_t>(key) * 0x9E3779B97F4A7C15ull) ^ seed; }
+    };
+    using Map = ChainedHashMap<int, int, SeededHash>;
+
+    Map source(resource.get(), 8, SeededHash{1});
+    source.max_load_factor(0.5f);
+    for (int key = 0; key < 100; ++key) source.insert(key, key * 2);
+
+    Map moved(resource.get(), 8, SeededHash{0x5555});
+    moved = std::move(source);
+    EXPECT_FLOAT_EQ(moved.max_load_factor(), 0.5f);
+
+    CustomMemoryResource other_resource;
+    Map moved_across(&other_resource, 8, SeededHash{7});
+    moved_across = std::move(moved);
+
+    Map copied(resource.get(), 8, SeededHash{9});
+    copied = moved_across;
+
+    for (int key = 0; key < 100; ++key) {
+        ASSERT_NE(moved_across.find(key), nullptr);
+        EXPECT_EQ(*moved_across.find(key), key * 2);
+        ASSERT_NE(copied.find(key), nullptr);
+        EXPECT_EQ(*copied.find(key), key * 2);
+    }
+    EXPECT_FLOAT_EQ(copied.max_load_factor(), 0.5f);
+}
+
+TEST_F(SingleLinkedListTest, RemoveIfKeepsListConsistentOnThrow) {
+    SingleLinkedList<int, TailTrackingPolicy> list(resource.get());
+    for (int i = 0; i < 10; ++i) list.push_back(i);
+
+    int calls = 0;
+    EXPECT_THROW(list.remove_if([&](int value) {
+        if (++calls == 6) throw std::runtime_error("predicate failed");
+        return value % 2 == 0;
+    }), std::runtime_error);
+
+    // Удалены 0, 2, 4; на элементе 5 условие бросило
+    EXPECT_EQ(to_vector(list), std::vector<int>({1, 3, 5, 6, 7, 8, 9}));
+    EXPECT_EQ(list.size(), 7u);
+    EXPECT_EQ(static_cast<size_t>(std::distance(list.begin(), list.end())), list.size());
+    EXPECT_EQ(resource->stats().blocks_live, 7u);
+    list.push_back(10);
+    EXPECT_EQ(list.back(), 10);
+
+    EXPECT_THROW(list.unique([](int, int) -> bool { throw std::runtime_error("predicate failed"); }),
+                 std::runtime_error);
+    EXPECT_EQ(list.size(), 8u);
+}
+
+TEST_F(SingleLinkedListTest, CompactListMoveAndSwapAcrossResources) {
+    CustomMemoryResource other_resource;
+    {
+        std::vector<int> values(3000);
+        std::iota(values.begin(), values.end(), 0);
+        CompactSingleLinkedList<int> source(values.begin(), values.end(), &other_resource);
+        CompactSingleLinkedList<int> target(resource.get());
+        target.push_front(-1);
+
+        target = std::move(source);
+        EXPECT_EQ(target.get_resource(), resource.get());
+        EXPECT_EQ(std::vector<int>(target.begin(), target.end()), values);
+        EXPECT_TRUE(source.empty());
+
+        CompactSingleLinkedList<int> other_list(&other_resource);
+        other_list.push_front(7);
+        other_list.push_front(8);
+        swap(target, other_list);
+        EXPECT_EQ(target.get_resource(), resource.get());
+        EXPECT_EQ(other_list.get_resource(), &other_resource);
+        EXPECT_EQ(std::vector<int>(target.begin(), target.end()), std::vector<int>({8, 7}));
+        EXPECT_EQ(std::vector<int>(other_list.begin(), other_list.end()), values);
+
+        // Равные ресурсы: обмен пулами без копирования
+        CompactSingleLinkedList<int> same(resource.get());
+        same.push_front(5);
+        target.swap(same);
+        EXPECT_EQ(std::vector<int>(target.begin(), target.end()), std::vector<int>({5}));
+        EXPECT_EQ(same.size(), 2u);
+    }
+    for (CustomMemoryResource* r : {resource.get(), &other_resource}) {
+        EXPECT_EQ(r->anomaly_count(AllocationAnomaly::UnknownPointer), 0u);
+        EXPECT_EQ(r->stats().blocks_live, 0u);
+    }
+}
+
+TEST_F(SingleLinkedListTest, SortAndMergeKeepNodesOnThrowingComparator) {
+    auto throwing_after = [](int limit) {
+        auto calls = std::make_shared<int>(0);
+        return [calls, limit](int a, int b) {
+            if (++*calls > limit) throw std::runtime_error("compare failed");
+            return a < b;
+        };
+    };
+    std::mt19937 rng(11);
+    std::vector<int> values(500);
+    for (int& value : values) value = static_cast<int>(rng() % 1000);
+
+    for (int limit : {0, 1, 7, 100, 1000, 3000}) {
+        SingleLinkedList<int, TailTrackingPolicy> list(values.begin(), values.end(), resource.get());
+        EXPECT_THROW(list.sort(throwing_after(limit)), std::runtime_error);
+        EXPECT_EQ(list.size(), values.size());
+        EXPECT_EQ(static_cast<size_t>(std::distance(list.begin(), list.end())), list.size());
+        std::vector<int> kept = to_vector(list);
+        EXPECT_TRUE(std::is_permutation(kept.begin(), kept.end(), values.begin()));
+        list.push_back(-1);
+        EXPECT_EQ(list.back(), -1);
+    }
+
+    for (int limit : {0, 5, 50}) {
+        SingleLinkedList<int, TailTrackingPolicy> first(resource.get());
+        SingleLinkedList<int, TailTrackingPolicy> second(resource.get());
+        for (int i = 0; i < 100; ++i) (i % 3 ? first : second).push_back(i);
+        EXPECT_THROW(first.merge(second, throwing_after(limit)), std::runtime_error);
+        EXPECT_EQ(first.size(), 100u);
+        EXPECT_EQ(static_cast<size_t>(std::distance(first.begin(), first.end())), 100u);
+        EXPECT_TRUE(second.empty());
+        EXPECT_EQ(second.begin(), second.end());
+        first.push_back(1000);
+        second.push_back(5);
+        EXPECT_EQ(first.back(), 1000);
+        EXPECT_EQ(second.back(), 5);
+    }
+    EXPECT_EQ(resource->stats().blocks_live, 0u);
+}